@@ -114,11 +114,9 @@ template<std::size_t Length, advent::string_viewable_range Rng>
 constexpr std::size_t count_unique_end_positions(Rng &&motion_descriptions) {
     Rope<Length> rope;
 
-    /*
-        There is probably a more efficient way to do this than a
-        vector of positions which we manually check for duplicates.
-    */
-    auto end_positions = std::vector{rope.back()};
+    auto end_positions = advent::flat_hash_set<typename Rope<Length>::Position>();
+    end_positions.insert(rope.back());
+
     for (const std::string_view description : std::forward<Rng>(motion_descriptions)) {
         if (description.empty()) {
             continue;
@@ -128,11 +126,7 @@ constexpr std::size_t count_unique_end_positions(Rng &&motion_descriptions) {
 
         for ([[maybe_unused]] const auto i : std::views::iota(0uz, motion.amount)) {
             rope.move(motion.direction);
-            const auto end_pos = rope.back();
-
-            if (!std::ranges::contains(end_positions, end_pos)) {
-                end_positions.push_back(end_pos);
-            }
+            end_positions.insert(rope.back());
         }
     }
 
@@ -0,0 +1,54 @@
+/*
+    Generates rock paths scattered below the sand's source
+    within a square of side length 'scale', centered under it.
+*/
+
+import std;
+import advent;
+
+int main(int argc, char **argv) {
+    return advent::generate_input(argc, argv, [](const std::size_t side_length, std::mt19937_64 &rng) {
+        /* Where the sand pours in from. */
+        static constexpr std::int64_t SourceX = 500;
+
+        const auto half_side = static_cast<std::int64_t>(side_length / 2);
+
+        const auto min_x = SourceX - half_side;
+        const auto max_x = SourceX + half_side;
+
+        /* NOTE: Rock starts below the source so that the source is never blocked. */
+        const auto min_y = std::int64_t{1};
+        const auto max_y = std::max(static_cast<std::int64_t>(side_length), min_y);
+
+        const auto max_segment_length = std::max(half_side / 4, std::int64_t{1});
+
+        const auto num_paths = std::max(side_length / 4, 1uz);
+
+        std::string input;
+
+        for (auto _ : std::views::iota(0uz, num_paths)) {
+            auto x = advent::random_between(rng, min_x, max_x);
+            auto y = advent::random_between(rng, min_y, max_y);
+
+            std::format_to(std::back_inserter(input), "{},{}", x, y);
+
+            const auto num_segments = advent::random_between(rng, 1uz, 4uz);
+            for (const auto segment : std::views::iota(0uz, num_segments)) {
+                const auto length = advent::random_between(rng, -max_segment_length, max_segment_length);
+
+                /* Alternate between horizontal and vertical lines, as real paths do. */
+                if (segment % 2 == 0) {
+                    x = std::clamp(x + length, min_x, max_x);
+                } else {
+                    y = std::clamp(y + length, min_y, max_y);
+                }
+
+                std::format_to(std::back_inserter(input), " -> {},{}", x, y);
+            }
+
+            input += '\n';
+        }
+
+        return input;
+    });
+}
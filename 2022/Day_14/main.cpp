@@ -15,7 +15,7 @@ struct Cave {
             return start.y() != end.y();
         }
 
-        std::vector<Position> positions;
+        advent::arena_vector<Position> positions;
 
         constexpr explicit Path(const std::string_view path) {
             advent::split_for_each(path, " -> ", [&](std::string_view pos) {
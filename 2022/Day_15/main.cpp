@@ -91,19 +91,29 @@ struct SensorRegion {
     }
 };
 
-template<Coord Row, advent::string_viewable_range Rng>
-constexpr std::size_t num_non_beacons_in_row(Rng &&sensors) {
-    std::vector<CoordRange> ranges;
-
-    std::vector<Coord> beacons_in_row;
+template<advent::string_viewable_range Rng>
+constexpr std::vector<SensorRegion> parse_regions(Rng &&sensors) {
+    /* We don't have an implementation of 'std::ranges::to'. */
+    std::vector<SensorRegion> regions;
 
     for (const std::string_view description : std::forward<Rng>(sensors)) {
         if (description.empty()) {
             continue;
         }
 
-        const auto region = SensorRegion(description);
+        regions.emplace_back(description);
+    }
+
+    return regions;
+}
+
+template<Coord Row>
+constexpr std::size_t num_non_beacons_in_row(const std::vector<SensorRegion> &regions) {
+    std::vector<CoordRange> ranges;
+
+    std::vector<Coord> beacons_in_row;
 
+    for (const auto &region : regions) {
         if (region.beacon.y() == Row && !std::ranges::contains(beacons_in_row, region.beacon.x())) {
             beacons_in_row.push_back(region.beacon.x());
         }
@@ -144,27 +154,16 @@ constexpr std::size_t tuning_frequency(const Position pos) {
     return 4'000'000 * static_cast<std::size_t>(pos.x()) + pos.y();
 }
 
-template<Coord Max, advent::string_viewable_range Rng>
+template<Coord Max>
 requires (Max > 0)
-constexpr std::size_t find_tuning_frequency(Rng &&sensors) {
+constexpr std::size_t find_tuning_frequency(const std::vector<SensorRegion> &regions) {
     /* Dear god forgive me for this code. */
 
-    /* We don't have an implementation of 'std::ranges::to'. */
-    const auto regions = [&]() {
-        std::vector<SensorRegion> regions;
-
-        for (const std::string_view description : std::forward<Rng>(sensors)) {
-            if (description.empty()) {
-                continue;
-            }
-
-            regions.emplace_back(description);
+    for (const auto row : std::views::iota(Coord{0}, Max + 1)) {
+        if (advent::cancellation_requested()) {
+            return 0;
         }
 
-        return regions;
-    }();
-
-    for (const auto row : std::views::iota(Coord{0}, Max + 1)) {
         CoordRange main;
 
         auto it = regions.begin();
@@ -285,6 +284,8 @@ constexpr std::size_t find_tuning_frequency(Rng &&sensors) {
 }
 
 consteval {
+    advent::input.is_parsed_by(^^parse_regions);
+
     advent::part_one.is_solved_by(^^num_non_beacons_in_row, 2'000'000);
     advent::part_two.is_solved_by(^^find_tuning_frequency,  4'000'000);
 }
@@ -32,26 +32,20 @@ constexpr std::size_t find_last_digit(std::string_view line, DigitMatcher auto &
 
 template<advent::string_viewable_range Rng>
 constexpr std::size_t find_sum_of_calibration_values(Rng &&rng, DigitMatcher auto first_matcher, DigitMatcher auto last_matcher) {
-    std::size_t sum = 0;
-
-    for (const std::string_view line : std::forward<Rng>(rng)) {
+    return advent::parallel_line_reduce(std::forward<Rng>(rng), [&](const std::string_view line) -> std::size_t {
         if (line.empty()) {
-            continue;
+            return 0;
         }
 
         const auto tens_digit = find_first_digit(line, first_matcher);
         const auto ones_digit = find_last_digit(line, last_matcher);
 
         /* NOTE: We already converted from characters to integrals. */
-        const auto calibration_value = (
+        return (
             10 * tens_digit +
             1  * ones_digit
         );
-
-        sum += calibration_value;
-    }
-
-    return sum;
+    }, std::plus{});
 }
 
 constexpr std::size_t find_sum_of_limited_calibration_values_from_string_data(const std::string_view data) {
@@ -2,8 +2,8 @@ import std;
 import advent;
 
 struct Card {
-    std::vector<std::size_t> winning_numbers;
-    std::vector<std::size_t> received_numbers;
+    advent::arena_vector<std::size_t> winning_numbers;
+    advent::arena_vector<std::size_t> received_numbers;
 
     constexpr explicit Card(const std::string_view description) {
         const auto colon_pos = description.find_first_of(':');
@@ -0,0 +1,71 @@
+/*
+    Generates an almanac whose seed ranges are each 'scale' seeds wide.
+
+    Each map's source ranges partition the same span of numbers
+    without overlapping, as they do in real inputs, and map them
+    to random destinations within that span.
+*/
+
+import std;
+import advent;
+
+int main(int argc, char **argv) {
+    return advent::generate_input(argc, argv, [](const std::size_t seed_range_width, std::mt19937_64 &rng) {
+        static constexpr std::size_t NumSeedRanges  = 10;
+        static constexpr std::size_t RangesPerMap   = 40;
+        static constexpr std::size_t MaxNumber      = (1uz << 32) - 1;
+
+        static constexpr std::string_view Categories[] = {
+            "seed",
+            "soil",
+            "fertilizer",
+            "water",
+            "light",
+            "temperature",
+            "humidity",
+            "location",
+        };
+
+        std::string input = "seeds:";
+
+        for (auto _ : std::views::iota(0uz, NumSeedRanges)) {
+            const auto start = advent::random_between(rng, 0uz, MaxNumber - seed_range_width);
+
+            std::format_to(std::back_inserter(input), " {} {}", start, seed_range_width);
+        }
+
+        input += '\n';
+
+        for (const auto [source, destination] : Categories | std::views::pairwise) {
+            /* NOTE: The last map must not be followed by an empty line, only preceded by one. */
+            std::format_to(std::back_inserter(input), "\n{}-to-{} map:\n", source, destination);
+
+            /* Split the span of numbers at random points, one range between each. */
+            auto bounds = std::vector<std::size_t>{0, MaxNumber + 1};
+            for (auto _ : std::views::iota(1uz, RangesPerMap)) {
+                bounds.push_back(advent::random_between(rng, 1uz, MaxNumber));
+            }
+
+            std::ranges::sort(bounds);
+
+            const auto [new_end, _] = std::ranges::unique(bounds);
+            bounds.erase(new_end, bounds.end());
+
+            for (const auto [start, end] : bounds | std::views::pairwise) {
+                const auto size = end - start;
+
+                std::format_to(
+                    std::back_inserter(input),
+
+                    "{} {} {}\n",
+
+                    advent::random_between(rng, 0uz, MaxNumber + 1 - size),
+                    start,
+                    size
+                );
+            }
+        }
+
+        return input;
+    });
+}
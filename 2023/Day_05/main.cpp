@@ -81,16 +81,22 @@ struct Map {
 
 constexpr inline std::string_view SeedsPrefix = "seeds: ";
 
+struct Almanac {
+    std::vector<std::size_t> seeds;
+    std::vector<Map> maps;
+};
+
 template<advent::string_viewable_range Rng>
-constexpr std::size_t minimum_location_of_seeds(Rng &&rng) {
+constexpr Almanac parse_almanac(Rng &&rng) {
+    Almanac almanac;
+
     auto it = std::ranges::begin(rng);
 
     const std::string_view seeds_description = *it;
     [[assume(seeds_description.starts_with(SeedsPrefix))]];
 
-    std::vector<std::size_t> sources;
     advent::split_for_each(seeds_description.substr(SeedsPrefix.size()), ' ', [&](const std::string_view seed) {
-        sources.push_back(advent::to_integral<std::size_t>(seed));
+        almanac.seeds.push_back(advent::to_integral<std::size_t>(seed));
     });
 
     /* Move past the first line and the following empty line. */
@@ -98,8 +104,16 @@ constexpr std::size_t minimum_location_of_seeds(Rng &&rng) {
     ++it;
 
     while (it != std::ranges::end(rng)) {
-        const auto map = Map::ParseAndAdvanceIterator(it);
+        almanac.maps.push_back(Map::ParseAndAdvanceIterator(it));
+    }
 
+    return almanac;
+}
+
+constexpr std::size_t minimum_location_of_seeds(const Almanac &almanac) {
+    auto sources = almanac.seeds;
+
+    for (const auto &map : almanac.maps) {
         for (auto &source : sources) {
             source = map.convert(source);
         }
@@ -108,58 +122,31 @@ constexpr std::size_t minimum_location_of_seeds(Rng &&rng) {
     return std::ranges::min(sources);
 }
 
-template<advent::string_viewable_range Rng>
-constexpr std::size_t minimum_location_of_seed_ranges(Rng &&rng) {
-    auto it = std::ranges::begin(rng);
-
-    std::string_view seeds_description = *it;
-    [[assume(seeds_description.starts_with(SeedsPrefix))]];
-
-    seeds_description.remove_prefix(SeedsPrefix.size());
+constexpr std::size_t minimum_location_of_seed_ranges(const Almanac &almanac) {
+    [[assume(almanac.seeds.size() % 2 == 0)]];
 
     std::vector<Map::SourceRange> source_ranges;
-    while (true) {
-        const auto first_end = seeds_description.find_first_of(' ');
-        [[assume(first_end != std::string_view::npos)]];
-
-        const auto second_end = seeds_description.find_first_of(' ', first_end + 1);
-
-        const auto start = advent::to_integral<std::size_t>(seeds_description.substr(0, first_end));
-        const auto size  = advent::to_integral<std::size_t>(seeds_description.substr(first_end + 1, second_end - first_end - 1));
-
-        source_ranges.emplace_back(start, size);
-
-        if (second_end == std::string_view::npos) {
-            break;
-        }
-
-        seeds_description.remove_prefix(second_end + 1);
+    for (const auto seed_pair : almanac.seeds | std::views::chunk(2)) {
+        source_ranges.emplace_back(seed_pair[0], seed_pair[1]);
     }
 
-    /* Move past the first line and the following empty line. */
-    ++it;
-    ++it;
-
-    const auto maps = [&]() {
-        std::vector<Map> maps;
-
-        while (it != std::ranges::end(rng)) {
-            maps.push_back(Map::ParseAndAdvanceIterator(it));
-        }
-
-        return maps;
-    }();
-
     /*
         NOTE: There is a better way to do this.
         I do not have the space in my brain today for it.
         Forgive me.
     */
 
+    /* NOTE: Checking for cancellation only so often keeps our inner loop tight. */
+    static constexpr std::size_t CancellationCheckInterval = 1uz << 20;
+
     auto location_minimum = std::numeric_limits<std::size_t>::max();
     for (const auto &source_range : source_ranges) {
         for (auto source : std::views::iota(source_range.start, source_range.end())) {
-            for (const auto &map : maps) {
+            if (source % CancellationCheckInterval == 0 && advent::cancellation_requested()) {
+                return location_minimum;
+            }
+
+            for (const auto &map : almanac.maps) {
                 source = map.convert(source);
             }
 
@@ -173,6 +160,8 @@ constexpr std::size_t minimum_location_of_seed_ranges(Rng &&rng) {
 }
 
 consteval {
+    advent::input.is_parsed_by(^^parse_almanac);
+
     advent::part_one.is_solved_by(^^minimum_location_of_seeds);
     advent::part_two.is_solved_by(^^minimum_location_of_seed_ranges);
 }
@@ -99,6 +99,8 @@ struct Map {
 
         [[assume(std::ranges::begin(rng) != std::ranges::end(rng))]];
 
+        const auto _ = advent::trace_scope("build map");
+
         struct IntermediateNode {
             std::string_view name;
             std::string_view left;
@@ -111,8 +113,6 @@ struct Map {
 
         std::vector<IntermediateNode> intermediate;
 
-        /* TODO: Investigate if this could be done better when I receive a constexpr 'std::flat_map'. */
-
         /*
             NOTE: We could encode the node names directly into
             convenient numbers, but I don't want to do that.
@@ -134,7 +134,25 @@ struct Map {
 
         this->nodes.reserve(intermediate.size());
 
+        const auto _ = advent::trace_scope("resolve node names");
+
+        const auto indices_by_name = advent::flat_map<std::string_view, std::size_t>(
+            std::vector(std::from_range, intermediate | std::views::transform(&IntermediateNode::name)),
+            std::vector(std::from_range, std::views::iota(0uz, intermediate.size()))
+        );
+
+        /* NOTE: Each node's left and right neighbours, one after the other. */
+        auto neighbour_names = std::vector<std::string_view>();
+        neighbour_names.reserve(2 * intermediate.size());
+
         for (const auto &intermediate_node : intermediate) {
+            neighbour_names.push_back(intermediate_node.left);
+            neighbour_names.push_back(intermediate_node.right);
+        }
+
+        const auto neighbour_indices = indices_by_name.find_each(neighbour_names);
+
+        for (const auto [i, intermediate_node] : intermediate | std::views::enumerate) {
             /*
                 NOTE: A potential optimization could be done here,
                 where we treat "degenerate" nodes, which can only
@@ -149,22 +167,8 @@ struct Map {
                 And I'm not sure the optimization would even be worth it anyhow.
             */
 
-            std::optional<std::size_t> left_index;
-            std::optional<std::size_t> right_index;
-
-            for (const auto [i, other_intermediate] : intermediate | std::views::enumerate) {
-                if (other_intermediate.name == intermediate_node.left) {
-                    left_index = i;
-                }
-
-                if (other_intermediate.name == intermediate_node.right) {
-                    right_index = i;
-                }
-
-                if (left_index.has_value() && right_index.has_value()) {
-                    break;
-                }
-            }
+            const auto &left_index  = neighbour_indices[2 * static_cast<std::size_t>(i)];
+            const auto &right_index = neighbour_indices[2 * static_cast<std::size_t>(i) + 1];
 
             [[assume(left_index.has_value() && right_index.has_value())]];
 
@@ -91,21 +91,15 @@ static_assert(!Report("1 5").safe_without_dampener());
 static_assert(!Report("1 5").safe_with_dampener());
 
 template<advent::string_viewable_range Rng, typename Predicate>
-requires (std::predicate<Predicate &, Report>)
-constexpr std::size_t count_reports_if(Rng &&rng, Predicate predicate) {
-    std::size_t num_safe_reports = 0;
-
-    for (const std::string_view line : std::forward<Rng>(rng)) {
+requires (std::predicate<const Predicate &, Report>)
+constexpr std::size_t count_reports_if(Rng &&rng, const Predicate predicate) {
+    return advent::parallel_line_reduce(std::forward<Rng>(rng), [&](const std::string_view line) -> std::size_t {
         if (line.empty()) {
-            continue;
-        }
-
-        if (std::invoke(predicate, Report(line))) {
-            ++num_safe_reports;
+            return 0;
         }
-    }
 
-    return num_safe_reports;
+        return std::invoke(predicate, Report(line)) ? 1uz : 0uz;
+    }, std::plus{});
 }
 
 template<advent::string_viewable_range Rng>
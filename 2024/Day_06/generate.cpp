@@ -0,0 +1,119 @@
+/*
+    Generates a square map with a side length of 'scale',
+    sparsely strewn with obstructions as in real inputs.
+
+    The guard is placed somewhere they will eventually leave
+    the map from, since part one relies on them doing so.
+*/
+
+import std;
+import advent;
+
+namespace {
+
+    struct Layout {
+        std::size_t side_length;
+
+        std::vector<bool> obstructions;
+
+        std::size_t guard_x;
+        std::size_t guard_y;
+
+        constexpr bool is_obstructed(this const Layout &self, const std::size_t x, const std::size_t y) {
+            return self.obstructions[y * self.side_length + x];
+        }
+
+        /* Walks the guard as the puzzle describes, and reports whether they escape. */
+        constexpr bool guard_escapes(this const Layout &self) {
+            static constexpr std::pair<std::ptrdiff_t, std::ptrdiff_t> Directions[] = {
+                { 0, -1},
+                { 1,  0},
+                { 0,  1},
+                {-1,  0},
+            };
+
+            auto seen = std::vector<bool>(self.obstructions.size() * std::size(Directions));
+
+            auto x         = self.guard_x;
+            auto y         = self.guard_y;
+            auto direction = 0uz;
+
+            while (true) {
+                auto &seen_state = seen[(y * self.side_length + x) * std::size(Directions) + direction];
+                if (seen_state) {
+                    return false;
+                }
+
+                seen_state = true;
+
+                const auto [dx, dy] = Directions[direction];
+
+                const auto next_x = x + static_cast<std::size_t>(dx);
+                const auto next_y = y + static_cast<std::size_t>(dy);
+
+                /* NOTE: Stepping off below zero wraps around to a huge number. */
+                if (next_x >= self.side_length || next_y >= self.side_length) {
+                    return true;
+                }
+
+                if (self.is_obstructed(next_x, next_y)) {
+                    direction = (direction + 1) % std::size(Directions);
+
+                    continue;
+                }
+
+                x = next_x;
+                y = next_y;
+            }
+        }
+    };
+
+}
+
+int main(int argc, char **argv) {
+    return advent::generate_input(argc, argv, [](const std::size_t side_length, std::mt19937_64 &rng) {
+        /* Real inputs have an obstruction on about one in twenty tiles. */
+        static constexpr std::size_t ObstructionOneIn = 20;
+
+        const auto random_layout = [&]() {
+            auto layout = Layout{
+                .side_length  = side_length,
+                .obstructions = std::vector<bool>(side_length * side_length),
+                .guard_x      = advent::random_between(rng, 0uz, side_length - 1),
+                .guard_y      = advent::random_between(rng, 0uz, side_length - 1),
+            };
+
+            for (auto &&obstructed : layout.obstructions) {
+                obstructed = (advent::random_between(rng, 1uz, ObstructionOneIn) == 1);
+            }
+
+            layout.obstructions[layout.guard_y * side_length + layout.guard_x] = false;
+
+            return layout;
+        };
+
+        auto layout = random_layout();
+        while (not layout.guard_escapes()) {
+            layout = random_layout();
+        }
+
+        std::string input;
+        input.reserve(side_length * (side_length + 1));
+
+        for (const auto y : std::views::iota(0uz, side_length)) {
+            for (const auto x : std::views::iota(0uz, side_length)) {
+                if (x == layout.guard_x && y == layout.guard_y) {
+                    input += '^';
+                } else if (layout.is_obstructed(x, y)) {
+                    input += '#';
+                } else {
+                    input += '.';
+                }
+            }
+
+            input += '\n';
+        }
+
+        return input;
+    });
+}
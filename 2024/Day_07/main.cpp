@@ -1,10 +1,9 @@
 import std;
 import advent;
 
-template<bool IncludeConcatenation>
 struct CalibrationRecord {
     std::size_t expected_result;
-    std::vector<std::size_t> operands;
+    advent::arena_vector<std::size_t> operands;
 
     constexpr explicit CalibrationRecord(const std::string_view description) {
         const auto result_end_pos = description.find_first_of(':');
@@ -20,6 +19,7 @@ struct CalibrationRecord {
         [[assume(this->operands.size() > 0)]];
     }
 
+    template<bool IncludeConcatenation>
     constexpr bool _is_possibly_correct(
         this const CalibrationRecord &self,
         std::size_t running_total,
@@ -40,45 +40,46 @@ struct CalibrationRecord {
             }
         }
 
-        if (self._is_possibly_correct(running_total, operand_index + 1, std::plus{})) {
+        if (self._is_possibly_correct<IncludeConcatenation>(running_total, operand_index + 1, std::plus{})) {
             return true;
         }
 
-        const bool mult_result = self._is_possibly_correct(running_total, operand_index + 1, std::multiplies{});
+        const bool mult_result = self._is_possibly_correct<IncludeConcatenation>(running_total, operand_index + 1, std::multiplies{});
 
         if constexpr (IncludeConcatenation) {
             if (mult_result) {
                 return true;
             }
 
-            return self._is_possibly_correct(running_total, operand_index + 1, advent::concat_digits{});
+            return self._is_possibly_correct<IncludeConcatenation>(running_total, operand_index + 1, advent::concat_digits{});
         } else {
             return mult_result;
         }
     }
 
+    template<bool IncludeConcatenation>
     constexpr bool is_possibly_correct(this const CalibrationRecord &self) {
-        if (self._is_possibly_correct(0, 0, std::plus{})) {
+        if (self._is_possibly_correct<IncludeConcatenation>(0, 0, std::plus{})) {
             return true;
         }
 
-        const auto mult_result = self._is_possibly_correct(0, 0, std::multiplies{});
+        const auto mult_result = self._is_possibly_correct<IncludeConcatenation>(0, 0, std::multiplies{});
 
         if constexpr (IncludeConcatenation) {
             if (mult_result) {
                 return true;
             }
 
-            return self._is_possibly_correct(0, 0, advent::concat_digits{});
+            return self._is_possibly_correct<IncludeConcatenation>(0, 0, advent::concat_digits{});
         } else {
             return mult_result;
         }
     }
 };
 
-template<bool IncludeConcatenation, advent::string_viewable_range Rng>
-constexpr std::vector<CalibrationRecord<IncludeConcatenation>> parse_records(Rng &&rng) {
-    std::vector<CalibrationRecord<IncludeConcatenation>> records;
+template<advent::string_viewable_range Rng>
+constexpr std::vector<CalibrationRecord> parse_records(Rng &&rng) {
+    std::vector<CalibrationRecord> records;
 
     for (const std::string_view line : std::forward<Rng>(rng)) {
         if (line.empty()) {
@@ -91,21 +92,20 @@ constexpr std::vector<CalibrationRecord<IncludeConcatenation>> parse_records(Rng
     return records;
 }
 
-template<bool IncludeConcatenation, advent::string_viewable_range Rng>
-constexpr std::size_t sum_possibly_correct_calibration_results(Rng &&rng) {
-    const auto records = parse_records<IncludeConcatenation>(std::forward<Rng>(rng));
-
-    std::size_t sum = 0;
-    for (const auto &record : records) {
-        if (record.is_possibly_correct()) {
-            sum += record.expected_result;
+template<bool IncludeConcatenation>
+constexpr std::size_t sum_possibly_correct_calibration_results(const std::vector<CalibrationRecord> &records) {
+    return advent::parallel_reduce(records, [](const CalibrationRecord &record) -> std::size_t {
+        if (record.is_possibly_correct<IncludeConcatenation>()) {
+            return record.expected_result;
         }
-    }
 
-    return sum;
+        return 0;
+    }, std::plus{});
 }
 
 consteval {
+    advent::input.is_parsed_by(^^parse_records);
+
     advent::part_one.is_solved_by(^^sum_possibly_correct_calibration_results, false);
     advent::part_two.is_solved_by(^^sum_possibly_correct_calibration_results, true);
 }
@@ -0,0 +1,25 @@
+/*
+    Generates a line of 'scale' stones, each engraved
+    with a number of up to six digits, as in real inputs.
+*/
+
+import std;
+import advent;
+
+int main(int argc, char **argv) {
+    return advent::generate_input(argc, argv, [](const std::size_t num_stones, std::mt19937_64 &rng) {
+        std::string input;
+
+        for (const auto i : std::views::iota(0uz, num_stones)) {
+            if (i > 0) {
+                input += ' ';
+            }
+
+            std::format_to(std::back_inserter(input), "{}", advent::random_between(rng, 0uz, 999'999uz));
+        }
+
+        input += '\n';
+
+        return input;
+    });
+}
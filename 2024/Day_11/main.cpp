@@ -1,27 +1,23 @@
 import std;
 import advent;
 
-struct StoneIterationResult {
-    std::size_t original_stone;
-    std::size_t iterations;
-    std::size_t num_stones;
-};
+/* The number of stones a stone becomes after some iterations, keyed by the stone and the number of iterations. */
+using StoneResults = advent::flat_hash_map<std::pair<std::size_t, std::size_t>, std::size_t>;
 
-constexpr std::size_t tick_stone_and_count(std::vector<StoneIterationResult> &results, const std::size_t stone, const std::size_t iterations) {
+constexpr std::size_t tick_stone_and_count(StoneResults &results, const std::size_t stone, const std::size_t iterations) {
     if (iterations == 0) {
         return 1;
     }
 
-    const auto it = std::ranges::find_if(results, [&](auto result) {
-        return result.original_stone == stone && result.iterations == iterations;
-    });
+    const auto key = std::pair(stone, iterations);
 
+    const auto it = results.find(key);
     if (it != results.end()) {
-        return it->num_stones;
+        return it->second;
     }
 
     const auto mark_and_return = [&](const std::size_t num_stones) {
-        results.emplace_back(stone, iterations, num_stones);
+        results.try_emplace(key, num_stones);
 
         return num_stones;
     };
@@ -55,8 +51,7 @@ constexpr std::size_t count_stones_after_iterations(std::string_view data) {
 
     std::size_t num_stones = 0;
 
-    /* NOTE: This would probably be faster with a hash map, but we need constexpr. */
-    std::vector<StoneIterationResult> results;
+    StoneResults results;
     advent::split_for_each(data, ' ', [&](const auto stone_repr) {
         /* NOTE: Stones do not affect each other so we can tick them individually. */
 
@@ -66,9 +61,77 @@ constexpr std::size_t count_stones_after_iterations(std::string_view data) {
     return num_stones;
 }
 
+struct StoneTally {
+    std::size_t stone;
+    std::size_t count;
+};
+
+/*
+    Rather than following each stone on its own, this ticks
+    every distinct stone at once, tallying how many there are
+    of each, as many stones quickly end up with the same number.
+*/
+template<std::size_t NumIterations>
+constexpr std::size_t count_stones_by_tally(std::string_view data) {
+    [[assume(!data.empty())]];
+    [[assume(data.back() == '\n')]];
+
+    data.remove_suffix(1);
+
+    std::vector<StoneTally> tallies;
+    advent::split_for_each(data, ' ', [&](const auto stone_repr) {
+        tallies.emplace_back(advent::to_integral<std::size_t>(stone_repr), 1uz);
+    });
+
+    std::vector<StoneTally> ticked;
+    for (auto _ : std::views::iota(0uz, NumIterations)) {
+        ticked.clear();
+
+        for (const auto [stone, count] : tallies) {
+            if (stone <= 0) {
+                ticked.emplace_back(1uz, count);
+
+                continue;
+            }
+
+            auto [num_digits, raised_base] = advent::count_digits_and_raise_base(stone, 10uz);
+
+            if (num_digits % 2 == 0) {
+                for (auto _ : std::views::iota(0uz, num_digits / 2)) {
+                    raised_base /= 10;
+                }
+
+                ticked.emplace_back(stone / raised_base, count);
+                ticked.emplace_back(stone % raised_base, count);
+
+                continue;
+            }
+
+            ticked.emplace_back(2024uz * stone, count);
+        }
+
+        /* Merge the tallies of any stones which now have the same number. */
+        std::ranges::sort(ticked, {}, &StoneTally::stone);
+
+        tallies.clear();
+        for (const auto &tally : ticked) {
+            if (not tallies.empty() && tallies.back().stone == tally.stone) {
+                tallies.back().count += tally.count;
+            } else {
+                tallies.push_back(tally);
+            }
+        }
+    }
+
+    return std::ranges::fold_left(tallies | std::views::transform(&StoneTally::count), 0uz, std::plus{});
+}
+
 consteval {
     advent::part_one.is_solved_by(^^count_stones_after_iterations, 25);
     advent::part_two.is_solved_by(^^count_stones_after_iterations, 75);
+
+    advent::part_one.is_also_solved_by("tally", ^^count_stones_by_tally, 25);
+    advent::part_two.is_also_solved_by("tally", ^^count_stones_by_tally, 75);
 }
 
 constexpr inline std::string_view example_data = (
@@ -76,6 +139,7 @@ constexpr inline std::string_view example_data = (
 );
 
 static_assert(advent::part_one() == 55312);
+static_assert(advent::part_one.variants_agree_on_example_data());
 
 int main(int argc, char **argv) {
     return advent::solve_puzzles(argc, argv);
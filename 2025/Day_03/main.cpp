@@ -38,19 +38,15 @@ struct Bank {
 
 template<std::size_t NumBatteries, advent::string_viewable_range Rng>
 constexpr std::size_t sum_bank_joltages(Rng &&rng) {
-    std::size_t sum = 0;
-
-    for (const std::string_view line : std::forward<Rng>(rng)) {
+    return advent::parallel_line_reduce(std::forward<Rng>(rng), [](const std::string_view line) -> std::size_t {
         if (line.empty()) {
-            continue;
+            return 0;
         }
 
         const auto bank = Bank{line};
 
-        sum += bank.find_max_joltage<NumBatteries>();
-    }
-
-    return sum;
+        return bank.find_max_joltage<NumBatteries>();
+    }, std::plus{});
 }
 
 consteval {
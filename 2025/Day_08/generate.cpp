@@ -0,0 +1,29 @@
+/*
+    Generates the locations of 'scale' junction boxes,
+    each coordinate being within the same bounds as real inputs.
+*/
+
+import std;
+import advent;
+
+int main(int argc, char **argv) {
+    return advent::generate_input(argc, argv, [](const std::size_t num_boxes, std::mt19937_64 &rng) {
+        static constexpr std::size_t MaxCoord = 99'999;
+
+        std::string input;
+
+        for (auto _ : std::views::iota(0uz, num_boxes)) {
+            std::format_to(
+                std::back_inserter(input),
+
+                "{},{},{}\n",
+
+                advent::random_between(rng, 0uz, MaxCoord),
+                advent::random_between(rng, 0uz, MaxCoord),
+                advent::random_between(rng, 0uz, MaxCoord)
+            );
+        }
+
+        return input;
+    });
+}
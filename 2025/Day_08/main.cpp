@@ -87,6 +87,8 @@ struct JunctionBoxes {
     constexpr explicit JunctionBoxes(const std::vector<Coords> &locations) {
         this->num_boxes = locations.size();
 
+        const auto _ = advent::trace_scope("fill distances");
+
         this->distance_storage.resize(StorageSizeForBoxCount(this->num_boxes));
 
         this->for_each_distance([&](const auto indices, std::size_t &distance) {
@@ -94,6 +96,13 @@ struct JunctionBoxes {
         });
     }
 
+    /* Takes distances which were already computed, such as those cached from an earlier run. */
+    constexpr JunctionBoxes(const std::size_t num_boxes, std::vector<std::size_t> distance_storage)
+    :
+        num_boxes(num_boxes),
+        distance_storage(std::move(distance_storage))
+    {}
+
     template<typename Consumer>
     requires (std::invocable<Consumer &, BoxIndices, std::size_t &>)
     constexpr void for_each_distance(this JunctionBoxes &self, Consumer &&consumer) {
@@ -167,26 +176,87 @@ struct JunctionBoxes {
     }
 };
 
-template<std::size_t AmountLargest, std::size_t Connections, advent::string_viewable_range Rng>
-constexpr std::size_t multiply_largest_circuit_lengths(Rng &&rng) {
-    auto circuit_lengths = JunctionBoxes(JunctionBoxes::ParseBoxLocations(std::forward<Rng>(rng)))
-        .circuit_lengths<Connections>();
+struct Playground {
+    std::vector<JunctionBoxes::Coords> box_locations;
+
+    /*
+        NOTE: Each part connects a copy of these boxes
+        so that the distances are only computed once.
+    */
+    JunctionBoxes boxes;
+
+    /*
+        Computing every distance is by far our slowest step,
+        and so we may cache them when run with '--cache'.
+    */
+    static constexpr std::uint32_t CacheVersion = 1;
+
+    void serialize(this const Playground &self, advent::cache_writer &writer) {
+        writer.write_span(std::span(self.box_locations));
+
+        writer.write(self.boxes.num_boxes);
+        writer.write_span(std::span(self.boxes.distance_storage));
+    }
+
+    static Playground Deserialize(advent::cache_reader &reader) {
+        const auto box_locations = reader.read_span<JunctionBoxes::Coords>();
+
+        const auto num_boxes        = reader.read<std::size_t>();
+        const auto distance_storage = reader.read_span<std::size_t>();
+
+        /* NOTE: We'd index out of bounds with anything we couldn't have written ourselves. */
+        const auto consistent = (
+            num_boxes >= 2                    &&
+            num_boxes == box_locations.size() &&
+
+            distance_storage.size() == JunctionBoxes::StorageSizeForBoxCount(num_boxes)
+        );
+
+        if (not consistent) {
+            reader.fail();
+
+            return Playground{{}, JunctionBoxes(0, {})};
+        }
+
+        return Playground{
+            std::vector(std::from_range, box_locations),
+
+            JunctionBoxes(num_boxes, std::vector(std::from_range, distance_storage))
+        };
+    }
+};
+
+static_assert(advent::cacheable<Playground>);
+
+template<advent::string_viewable_range Rng>
+constexpr Playground parse_playground(Rng &&rng) {
+    auto box_locations = JunctionBoxes::ParseBoxLocations(std::forward<Rng>(rng));
+    auto boxes         = JunctionBoxes(box_locations);
+
+    return Playground{std::move(box_locations), std::move(boxes)};
+}
+
+template<std::size_t AmountLargest, std::size_t Connections>
+constexpr std::size_t multiply_largest_circuit_lengths(const Playground &playground) {
+    auto circuit_lengths = JunctionBoxes(playground.boxes).circuit_lengths<Connections>();
 
     const auto max_lengths = advent::find_maxes<AmountLargest>(circuit_lengths);
 
     return std::ranges::fold_left(max_lengths, 1uz, std::multiplies{});
 }
 
-template<advent::string_viewable_range Rng>
-constexpr std::size_t multiply_last_wall_distances(Rng &&rng) {
-    const auto box_locations = JunctionBoxes::ParseBoxLocations(std::forward<Rng>(rng));
-
-    const auto last_connected = JunctionBoxes(box_locations).connect_all();
+constexpr std::size_t multiply_last_wall_distances(const Playground &playground) {
+    const auto last_connected = JunctionBoxes(playground.boxes).connect_all();
 
-    return box_locations[last_connected.first].x() * box_locations[last_connected.second].x();
+    return (
+        playground.box_locations[last_connected.first].x() *
+        playground.box_locations[last_connected.second].x()
+    );
 }
 
 consteval {
+    advent::input.is_parsed_by(^^parse_playground);
+
     advent::part_one.is_solved_by(^^multiply_largest_circuit_lengths, 3, 10);
     advent::part_two.is_solved_by(^^multiply_last_wall_distances);
 }
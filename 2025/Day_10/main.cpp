@@ -145,19 +145,13 @@ struct StartingMachine {
 
 template<typename Machine, advent::string_viewable_range Rng>
 constexpr std::size_t sum_minimum_button_presses(Rng &&rng) {
-    std::size_t sum = 0;
-
-    for (const std::string_view line : std::forward<Rng>(rng)) {
+    return advent::parallel_line_reduce(std::forward<Rng>(rng), [](const std::string_view line) -> std::size_t {
         if (line.empty()) {
-            continue;
+            return 0;
         }
 
-        const auto min = Machine(line).min_needed_buttons();
-
-        sum += min;
-    }
-
-    return sum;
+        return Machine(line).min_needed_buttons();
+    }, std::plus{});
 }
 
 consteval {
@@ -6,11 +6,32 @@ export import :type_aliases;
 export import :math;
 export import :digits;
 export import :split_string_view;
+export import :line_index;
 export import :views;
 export import :vector_nd;
+export import :flat_hash_map;
+export import :flat_map;
 export import :grid;
 export import :functional;
 export import :type_traits;
 export import :print;
 export import :timer;
+export import :perf_counters;
+export import :allocations;
+export import :arena;
+export import :cancellation;
+export import :watchdog;
+export import :benchmark_environment;
+export import :trace;
+export import :statistics;
+export import :report;
+export import :options;
+export import :generator;
+export import :process;
+export import :thread_pool;
+export import :parallel;
+export import :registry;
+export import :mapped_file;
+export import :parse_cache;
+export import :input_stream;
 export import :puzzle_data;
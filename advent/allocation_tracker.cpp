@@ -0,0 +1,69 @@
+/*
+    Replaces the global allocation functions so that
+    'advent::allocation_tracker' can count allocations.
+
+    This is linked into each day when 'ADVENT_TRACK_ALLOCATIONS'
+    is enabled, and so is deliberately not part of the module.
+
+    NOTE: Only the plain and aligned forms need replacing, since
+    the array, nothrow, and sized forms all forward to them.
+*/
+
+/* NOTE: Needed for 'malloc_usable_size'. */
+#include <malloc.h>
+
+import std;
+import advent;
+
+namespace {
+
+    [[maybe_unused]]
+    const auto Installed = []() {
+        advent::allocation_tracker::install();
+
+        return true;
+    }();
+
+    auto tracked_allocation(void *ptr, const std::size_t size) -> void * {
+        if (ptr == nullptr) {
+            throw std::bad_alloc();
+        }
+
+        advent::allocation_tracker::record_allocation(size, ::malloc_usable_size(ptr));
+
+        return ptr;
+    }
+
+    auto tracked_free(void *ptr) noexcept -> void {
+        if (ptr == nullptr) {
+            return;
+        }
+
+        advent::allocation_tracker::record_free(::malloc_usable_size(ptr));
+
+        std::free(ptr);
+    }
+
+}
+
+auto operator new(std::size_t size) -> void * {
+    /* NOTE: 'malloc' may return null for a size of 0, but 'operator new' may not. */
+    return tracked_allocation(std::malloc(std::max(size, 1uz)), size);
+}
+
+auto operator new(std::size_t size, std::align_val_t alignment) -> void * {
+    const auto align = static_cast<std::size_t>(alignment);
+
+    /* NOTE: 'aligned_alloc' requires the size to be a multiple of the alignment. */
+    const auto padded_size = std::max((size + align - 1) / align * align, align);
+
+    return tracked_allocation(std::aligned_alloc(align, padded_size), size);
+}
+
+auto operator delete(void *ptr) noexcept -> void {
+    tracked_free(ptr);
+}
+
+auto operator delete(void *ptr, std::align_val_t) noexcept -> void {
+    tracked_free(ptr);
+}
@@ -0,0 +1,143 @@
+export module advent:allocations;
+
+import std;
+
+namespace advent {
+
+    /* What was allocated over a measured scope. */
+    export struct allocation_counts {
+        std::size_t num_allocations = 0;
+        std::size_t num_frees       = 0;
+
+        std::size_t bytes_allocated = 0;
+
+        /* The most bytes live at once beyond what was live when the scope began. */
+        std::size_t peak_live_bytes = 0;
+
+        /*
+            Divides each count, such as to average them over several iterations.
+
+            NOTE: The peak is left as is, since it's already per iteration.
+        */
+        constexpr allocation_counts operator /(this const allocation_counts &self, const std::size_t divisor) {
+            return allocation_counts{
+                .num_allocations = self.num_allocations / divisor,
+                .num_frees       = self.num_frees       / divisor,
+                .bytes_allocated = self.bytes_allocated / divisor,
+                .peak_live_bytes = self.peak_live_bytes,
+            };
+        }
+    };
+
+    /*
+        Counts the allocations made by the calling thread.
+
+        Nothing is counted unless the allocation tracker, which
+        replaces the global 'operator new' and 'operator delete',
+        is linked in, as it is with 'ADVENT_TRACK_ALLOCATIONS'.
+
+        NOTE: Memory freed by a different thread than allocated
+        it counts against the freeing thread's live bytes.
+    */
+    export struct allocation_tracker {
+        struct thread_counters {
+            std::size_t num_allocations = 0;
+            std::size_t num_frees       = 0;
+
+            std::size_t bytes_allocated = 0;
+
+            std::ptrdiff_t live_bytes      = 0;
+            std::ptrdiff_t peak_live_bytes = 0;
+        };
+
+        /* NOTE: Constant-initialized, so that allocating never needs to initialize it. */
+        static inline constinit thread_local thread_counters _counters = {};
+
+        static inline constinit std::atomic<bool> _installed = false;
+
+        allocation_counts _counts;
+
+        static auto install() -> void {
+            _installed.store(true, std::memory_order_relaxed);
+        }
+
+        static constexpr auto is_installed() -> bool {
+            if consteval {
+                return false;
+            } else {
+                return _installed.load(std::memory_order_relaxed);
+            }
+        }
+
+        /*
+            NOTE: These are called from within 'operator new' and
+            'operator delete', and so must never allocate themselves.
+        */
+
+        static auto record_allocation(const std::size_t requested_bytes, const std::size_t usable_bytes) noexcept -> void {
+            auto &counters = _counters;
+
+            counters.num_allocations += 1;
+            counters.bytes_allocated += requested_bytes;
+
+            counters.live_bytes     += static_cast<std::ptrdiff_t>(usable_bytes);
+            counters.peak_live_bytes = std::max(counters.peak_live_bytes, counters.live_bytes);
+        }
+
+        static auto record_free(const std::size_t usable_bytes) noexcept -> void {
+            auto &counters = _counters;
+
+            counters.num_frees  += 1;
+            counters.live_bytes -= static_cast<std::ptrdiff_t>(usable_bytes);
+        }
+
+        constexpr const allocation_counts &last_measured_counts(this const allocation_tracker &self) {
+            return self._counts;
+        }
+
+        [[nodiscard]]
+        constexpr auto measure_scope(this allocation_tracker &self) {
+            struct scope_measurer {
+                scope_measurer(const scope_measurer &) = delete;
+                scope_measurer &operator =(const scope_measurer &) = delete;
+
+                scope_measurer(scope_measurer &&) = delete;
+                scope_measurer &operator =(scope_measurer &&) = delete;
+
+                allocation_tracker &_tracker;
+
+                thread_counters _start = {};
+
+                constexpr explicit scope_measurer(allocation_tracker &tracker) : _tracker(tracker) {
+                    if !consteval {
+                        /* Only peaks reached from here on are ours. */
+                        _counters.peak_live_bytes = _counters.live_bytes;
+
+                        this->_start = _counters;
+                    }
+                }
+
+                constexpr ~scope_measurer() {
+                    if consteval {
+                        this->_tracker._counts = allocation_counts{};
+                    } else {
+                        const auto &end = _counters;
+
+                        this->_tracker._counts = allocation_counts{
+                            .num_allocations = end.num_allocations - this->_start.num_allocations,
+                            .num_frees       = end.num_frees       - this->_start.num_frees,
+                            .bytes_allocated = end.bytes_allocated - this->_start.bytes_allocated,
+
+                            .peak_live_bytes = static_cast<std::size_t>(
+                                std::max(end.peak_live_bytes - this->_start.live_bytes, std::ptrdiff_t{0})
+                            ),
+                        };
+                    }
+                }
+            };
+
+            return scope_measurer(self);
+        }
+    };
+
+}
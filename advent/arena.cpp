@@ -0,0 +1,150 @@
+export module advent:arena;
+
+import std;
+
+import :scope_guard;
+
+namespace advent {
+
+    /*
+        A region of memory which is allocated from by simply bumping
+        a pointer along, and which is freed all at once, such as for
+        the many short-lived containers built while solving a part.
+
+        While an arena is in use by a thread, every 'advent::arena_allocator'
+        default-constructed on that thread allocates from the arena.
+
+        NOTE: During constant evaluation we have no arena,
+        and so everything is allocated as it normally would be.
+    */
+    export struct arena {
+        /* NOTE: Allocating beyond this falls back to ever larger chunks from the heap. */
+        static constexpr std::size_t InitialSize = 1uz << 20;
+
+        /* The memory resource in use by the current thread, if any. */
+        static inline constinit thread_local std::pmr::memory_resource *_current = nullptr;
+
+        std::unique_ptr<std::byte[]> _initial_buffer;
+
+        std::unique_ptr<std::pmr::monotonic_buffer_resource> _resource;
+
+        constexpr arena() {
+            if !consteval {
+                this->_initial_buffer = std::make_unique_for_overwrite<std::byte[]>(InitialSize);
+
+                this->_resource = std::make_unique<std::pmr::monotonic_buffer_resource>(
+                    this->_initial_buffer.get(), InitialSize
+                );
+            }
+        }
+
+        static constexpr auto current_resource() -> std::pmr::memory_resource * {
+            if consteval {
+                return nullptr;
+            } else {
+                return _current;
+            }
+        }
+
+        constexpr auto resource(this const arena &self) -> std::pmr::memory_resource * {
+            return self._resource.get();
+        }
+
+        /*
+            Frees everything allocated from the arena, and
+            goes back to allocating from its initial buffer.
+
+            NOTE: Nothing allocated from the arena may be used after this.
+        */
+        constexpr auto release(this arena &self) -> void {
+            if (self._resource != nullptr) {
+                self._resource->release();
+            }
+        }
+
+        /* Has the calling thread allocate from this arena until the returned guard is destroyed. */
+        [[nodiscard]]
+        constexpr auto use_scope(this const arena &self) {
+            auto *previous = arena::current_resource();
+
+            if !consteval {
+                _current = self.resource();
+            }
+
+            return advent::scope_guard([previous]() {
+                if !consteval {
+                    _current = previous;
+                }
+            });
+        }
+    };
+
+    /*
+        Allocates from the arena in use by the thread which constructed
+        it, or just as 'std::allocator' does when there wasn't one.
+
+        NOTE: Copying a container gives the copy whichever arena is in use
+        by the copying thread, so that no two threads share the same arena.
+    */
+    export template<typename T>
+    struct arena_allocator {
+        using value_type = T;
+
+        using propagate_on_container_copy_assignment = std::false_type;
+        using propagate_on_container_move_assignment = std::true_type;
+        using propagate_on_container_swap            = std::true_type;
+
+        std::pmr::memory_resource *_resource = nullptr;
+
+        constexpr arena_allocator() noexcept : _resource(advent::arena::current_resource()) {}
+
+        template<typename U>
+        constexpr explicit(false) arena_allocator(const arena_allocator<U> &other) noexcept : _resource(other._resource) {}
+
+        constexpr auto select_on_container_copy_construction(this const arena_allocator &) -> arena_allocator {
+            return arena_allocator();
+        }
+
+        constexpr auto allocate(this const arena_allocator &self, const std::size_t num_objects) -> T * {
+            if consteval {
+                return std::allocator<T>().allocate(num_objects);
+            } else {
+                if (self._resource == nullptr) {
+                    return std::allocator<T>().allocate(num_objects);
+                }
+
+                return static_cast<T *>(self._resource->allocate(num_objects * sizeof(T), alignof(T)));
+            }
+        }
+
+        constexpr auto deallocate(this const arena_allocator &self, T *pointer, const std::size_t num_objects) -> void {
+            if consteval {
+                std::allocator<T>().deallocate(pointer, num_objects);
+            } else {
+                if (self._resource == nullptr) {
+                    std::allocator<T>().deallocate(pointer, num_objects);
+
+                    return;
+                }
+
+                self._resource->deallocate(pointer, num_objects * sizeof(T), alignof(T));
+            }
+        }
+
+        template<typename U>
+        constexpr bool operator ==(this const arena_allocator &self, const arena_allocator<U> &rhs) {
+            return self._resource == rhs._resource;
+        }
+    };
+
+    export template<typename T>
+    using arena_vector = std::vector<T, advent::arena_allocator<T>>;
+
+    static_assert([]() {
+        auto numbers = advent::arena_vector<int>{1, 2, 3};
+        numbers.push_back(4);
+
+        return std::ranges::fold_left(numbers, 0, std::plus{}) == 10;
+    }());
+
+}
@@ -0,0 +1,156 @@
+module;
+
+/* NOTE: Needed for 'sched_setaffinity', 'setpriority' and friends. */
+#include <sched.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+export module advent:benchmark_environment;
+
+import std;
+
+import :print;
+import :report;
+import :timer;
+
+namespace advent {
+
+    namespace impl {
+
+        /* The CPUs we were allowed to run on before being pinned, if we've been pinned. */
+        inline auto affinity_before_pinning() -> std::optional<cpu_set_t> & {
+            static std::optional<cpu_set_t> affinity;
+
+            return affinity;
+        }
+
+    }
+
+    /*
+        Pins the calling thread to 'cpu', so that it isn't migrated
+        between cores, losing its caches, while it's being timed.
+
+        NOTE: Threads spawned afterwards inherit this same affinity,
+        so helper threads, such as those of a thread pool, must call
+        'advent::unpin_current_thread' lest they all share our one CPU.
+    */
+    export auto pin_current_thread(const std::size_t cpu) -> bool {
+        if (cpu >= CPU_SETSIZE) {
+            return false;
+        }
+
+        auto &previous = impl::affinity_before_pinning();
+        if (not previous.has_value()) {
+            cpu_set_t current;
+            if (::sched_getaffinity(0, sizeof(current), &current) == 0) {
+                previous = current;
+            }
+        }
+
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(cpu, &cpus);
+
+        /* NOTE: A pid of zero refers to the calling thread. */
+        return ::sched_setaffinity(0, sizeof(cpus), &cpus) == 0;
+    }
+
+    /* Lets the calling thread run on whichever CPUs we could before 'advent::pin_current_thread'. */
+    export auto unpin_current_thread() -> void {
+        const auto &previous = impl::affinity_before_pinning();
+        if (not previous.has_value()) {
+            return;
+        }
+
+        ::sched_setaffinity(0, sizeof(*previous), &*previous);
+    }
+
+    /* Gives the calling thread the highest priority we're allowed to, returning whether that was raised at all. */
+    export auto raise_current_thread_priority() -> bool {
+        static constexpr int HighestPriority = -20;
+
+        /* NOTE: On Linux, a 'who' of zero refers to the calling thread rather than the whole process. */
+        const auto previous = ::getpriority(PRIO_PROCESS, 0);
+
+        for (auto priority = HighestPriority; priority < previous; ++priority) {
+            if (::setpriority(PRIO_PROCESS, 0, priority) == 0) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /* The frequency scaling governor of 'cpu', such as "performance" or "powersave", if it has one. */
+    export auto cpu_scaling_governor(const std::size_t cpu) -> std::optional<std::string> {
+        auto file = std::ifstream(std::format("/sys/devices/system/cpu/cpu{}/cpufreq/scaling_governor", cpu));
+
+        std::string governor;
+        if (not std::getline(file, governor)) {
+            return std::nullopt;
+        }
+
+        return governor;
+    }
+
+    export auto current_cpu() -> std::optional<std::size_t> {
+        const auto cpu = ::sched_getcpu();
+        if (cpu < 0) {
+            return std::nullopt;
+        }
+
+        return static_cast<std::size_t>(cpu);
+    }
+
+    /*
+        Reads a byte from every page of 'data', so that none
+        of them are first faulted in while being timed, such
+        as when our input was read rather than mapped.
+    */
+    export auto pre_touch(const std::string_view data) -> void {
+        static const auto PageSize = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+
+        unsigned char checksum = 0;
+        for (auto pos = 0uz; pos < data.size(); pos += PageSize) {
+            checksum ^= static_cast<unsigned char>(data[pos]);
+        }
+
+        advent::do_not_optimize(checksum);
+    }
+
+    /*
+        Readies the calling thread for repeatable timings, warning
+        about anything which would make them less so, such as
+        a CPU which may change its frequency while we're timed.
+
+        NOTE: We only warn in 'format's meant for people,
+        since warnings would corrupt our records otherwise.
+    */
+    export auto prepare_benchmark_environment(const std::optional<std::size_t> pinned_cpu, const bool raise_priority, const advent::output_format format) -> void {
+        const auto warn = (format == advent::output_format::human);
+
+        if (pinned_cpu.has_value() && not advent::pin_current_thread(*pinned_cpu) && warn) {
+            advent::println("Warning: unable to pin to CPU {}, timings may vary as we migrate between cores.", *pinned_cpu);
+        }
+
+        if (raise_priority && not advent::raise_current_thread_priority() && warn) {
+            advent::println("Warning: unable to raise our priority, other processes may interrupt our timings.");
+        }
+
+        if (not warn) {
+            return;
+        }
+
+        const auto cpu = pinned_cpu.has_value() ? pinned_cpu : advent::current_cpu();
+        if (not cpu.has_value()) {
+            return;
+        }
+
+        /* NOTE: Without frequency scaling, there's no governor, and nothing to warn about. */
+        const auto governor = advent::cpu_scaling_governor(*cpu);
+        if (governor.has_value() && *governor != "performance") {
+            advent::println("Warning: CPU {} uses the '{}' scaling governor, timings may vary with its frequency.", *cpu, *governor);
+        }
+    }
+
+}
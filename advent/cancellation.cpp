@@ -0,0 +1,65 @@
+export module advent:cancellation;
+
+import std;
+
+import :scope_guard;
+
+namespace advent {
+
+    /*
+        Lets a long-running solver be asked to give up, such as
+        once it has run over its budget. Solvers are never stopped
+        outright, but should poll 'advent::cancellation_requested'
+        from their inner loops and return early once it's true.
+
+        NOTE: Only the thread which uses a source sees its requests,
+        so solvers which spread their work across other threads must
+        poll from the thread they were called on.
+    */
+    export struct cancellation_source {
+        /* The flag polled by the current thread, if any. */
+        static inline constinit thread_local const std::atomic<bool> *_current = nullptr;
+
+        std::atomic<bool> _requested = false;
+
+        auto request_cancellation(this cancellation_source &self) -> void {
+            self._requested.store(true, std::memory_order_relaxed);
+        }
+
+        auto is_cancellation_requested(this const cancellation_source &self) -> bool {
+            return self._requested.load(std::memory_order_relaxed);
+        }
+
+        /* Has the calling thread poll this source until the returned guard is destroyed. */
+        [[nodiscard]]
+        constexpr auto use_scope(this const cancellation_source &self) {
+            const std::atomic<bool> *previous = nullptr;
+
+            if !consteval {
+                previous = std::exchange(_current, &self._requested);
+            }
+
+            return advent::scope_guard([previous]() {
+                if !consteval {
+                    _current = previous;
+                }
+            });
+        }
+    };
+
+    /*
+        Whether the solver running on this thread has been asked to give up.
+
+        The answer it then returns is discarded, so it may return anything.
+    */
+    export constexpr auto cancellation_requested() -> bool {
+        if consteval {
+            return false;
+        } else {
+            const auto requested = advent::cancellation_source::_current;
+
+            return requested != nullptr && requested->load(std::memory_order_relaxed);
+        }
+    }
+
+}
@@ -55,21 +55,63 @@ namespace advent {
         }
     }
 
+    namespace impl {
+
+        /* Reads eight bytes such that the first is the least significant, as on a little-endian machine. */
+        constexpr std::uint64_t load_eight_chars(const char *data) {
+            if consteval {
+                std::uint64_t loaded = 0;
+                for (const auto i : std::views::iota(0uz, 8uz)) {
+                    loaded |= std::uint64_t{static_cast<unsigned char>(data[i])} << (8 * i);
+                }
+
+                return loaded;
+            } else {
+                std::uint64_t loaded;
+                std::memcpy(&loaded, data, sizeof(loaded));
+
+                if constexpr (std::endian::native == std::endian::big) {
+                    loaded = std::byteswap(loaded);
+                }
+
+                return loaded;
+            }
+        }
+
+        /*
+            Converts eight ASCII decimal digits, the first being the
+            most significant, with only three multiplications by
+            combining adjacent digits, then pairs, then quadruplets.
+        */
+        constexpr std::uint64_t parse_eight_digits(const char *data) {
+            auto chunk = impl::load_eight_chars(data) - 0x3030303030303030;
+
+            /* Each byte pair now holds '10 * first + second'. */
+            chunk = ((chunk * (10 * (1 << 8) + 1)) >> 8) & 0x00FF00FF00FF00FF;
+
+            /* Each 16-bit pair now holds '100 * first + second'. */
+            chunk = ((chunk * (100 * (1 << 16) + 1)) >> 16) & 0x0000FFFF0000FFFF;
+
+            /* And finally the two halves are combined. */
+            return (chunk * (10000 * (1uz << 32) + 1)) >> 32;
+        }
+
+        static_assert(impl::parse_eight_digits("12345678") == 12345678);
+        static_assert(impl::parse_eight_digits("00000000") == 0);
+        static_assert(impl::parse_eight_digits("99999999") == 99999999);
+
+    }
+
     template<std::integral ToConvert, ToConvert Base>
     struct _to_integral_fn {
-        template<std::ranges::input_range R>
-        requires (
-            /*
-                We stop char arrays from using this overload so
-                that they can be converted to a 'std::string_view'
-                by another overload.
-            */
-            !advent::array_of<R, char>                        &&
-            std::same_as<std::ranges::range_value_t<R>, char>
-        )
-        [[nodiscard]]
-        static constexpr ToConvert operator ()(R &&str) {
-            auto it = std::ranges::begin(str);
+        struct _prefix_info {
+            ToConvert sign;
+            ToConvert base;
+        };
+
+        /* Consumes any sign and base prefix, such as in "-0x200". */
+        template<std::input_iterator It>
+        static constexpr _prefix_info _parse_prefix(It &it) {
             const auto sign = [&]() {
                 if constexpr (std::unsigned_integral<ToConvert>) {
                     [[assume(*it != '-')]];
@@ -120,44 +162,91 @@ namespace advent {
                 }
             }();
 
-            /* If our range is only an input range and is not sized, just stuff the range into a vector. */
-            auto rng = [&]() {
-                /* Use a subrange as getting the sign and base may have incremented 'it'. */
-                auto subrange = std::ranges::subrange(std::move(it), std::ranges::end(str));
+            return {sign, base};
+        }
 
-                using Subrange = decltype(subrange);
-                if constexpr (!std::ranges::sized_range<Subrange> && !std::ranges::forward_range<Subrange>) {
-                    return std::vector(std::from_range, std::move(subrange));
-                } else {
-                    return subrange;
-                }
-            }();
+        static constexpr ToConvert _digit_value(const char digit) {
+            if (digit >= 'a' && digit <= 'f') {
+                return static_cast<ToConvert>(digit - 'a' + 0xa);
+            }
 
-            auto digit_place = [&]() {
-                /* If we have a sized range, use the size. Else use the distance from the start to end of the range. */
-                if constexpr (std::ranges::sized_range<decltype(rng)>) {
-                    return std::ranges::size(rng) - 1;
-                } else {
-                    return std::ranges::distance(std::ranges::begin(rng), std::ranges::end(rng)) - 1;
-                }
-            }();
+            if (digit >= 'A' && digit <= 'F') {
+                return static_cast<ToConvert>(digit - 'A' + 0xA);
+            }
+
+            return static_cast<ToConvert>(digit - '0');
+        }
 
+        /* Accumulates the digits from most to least significant, as in Horner's method. */
+        template<typename It, typename Sentinel>
+        static constexpr ToConvert _accumulate_digits(It it, const Sentinel end, const ToConvert base) {
             ToConvert converted = 0;
-            for (const auto digit : std::move(rng)) {
+            for (; it != end; ++it) {
+                const char digit = *it;
+
                 [[assume(advent::is_digit(digit, base))]];
 
-                if (digit >= '0' && digit <= '9') {
-                    converted += static_cast<ToConvert>(advent::pow(base, digit_place) * (digit - '0' + 0));
-                } else if (digit >= 'a' && digit <= 'f') {
-                    converted += static_cast<ToConvert>(advent::pow(base, digit_place) * (digit - 'a' + 0xa));
-                } else if (digit >= 'A' && digit <= 'F') {
-                    converted += static_cast<ToConvert>(advent::pow(base, digit_place) * (digit - 'A' + 0xA));
-                }
+                converted = static_cast<ToConvert>(converted * base + _to_integral_fn::_digit_value(digit));
+            }
+
+            return converted;
+        }
+
+        /*
+            The fast path, for when our digits are all laid
+            out in memory, which is how nearly every day
+            parses its numbers, from 'std::string_view's.
+        */
+        [[nodiscard]]
+        static constexpr ToConvert operator ()(std::string_view str) {
+            auto it = str.begin();
+            const auto [sign, base] = _to_integral_fn::_parse_prefix(it);
+
+            str = std::string_view(it, str.end());
+
+            if (base != 10) {
+                return static_cast<ToConvert>(sign * _to_integral_fn::_accumulate_digits(str.begin(), str.end(), base));
+            }
+
+            /* NOTE: Accumulating in 64 bits lets leading zeros make up a full chunk without overflowing. */
+            std::uint64_t converted = 0;
+            while (str.size() >= 8) {
+                converted = converted * 100'000'000 + impl::parse_eight_digits(str.data());
+
+                str.remove_prefix(8);
+            }
+
+            for (const auto digit : str) {
+                [[assume(advent::is_digit(digit, 10))]];
 
-                --digit_place;
+                converted = converted * 10 + static_cast<std::uint64_t>(digit - '0');
             }
 
-            return sign * converted;
+            return static_cast<ToConvert>(sign * static_cast<ToConvert>(converted));
+        }
+
+        template<std::ranges::input_range R>
+        requires (
+            /*
+                We stop char arrays from using this overload so
+                that they can be converted to a 'std::string_view'
+                by another overload.
+            */
+            !advent::array_of<R, char>                        &&
+            std::same_as<std::ranges::range_value_t<R>, char>
+        )
+        [[nodiscard]]
+        static constexpr ToConvert operator ()(R &&str) {
+            /* Anything laid out like a 'std::string_view' may take its fast path. */
+            if constexpr (std::ranges::contiguous_range<R> && std::ranges::sized_range<R>) {
+                return _to_integral_fn::operator ()(std::string_view(std::ranges::data(str), std::ranges::size(str)));
+            } else {
+                auto it = std::ranges::begin(str);
+                const auto [sign, base] = _to_integral_fn::_parse_prefix(it);
+
+                /* NOTE: We make only a single pass, and so work with any input range. */
+                return static_cast<ToConvert>(sign * _to_integral_fn::_accumulate_digits(std::move(it), std::ranges::end(str), base));
+            }
         }
 
         template<std::size_t N>
@@ -184,6 +273,16 @@ namespace advent {
     static_assert(advent::to_integral<std::uint8_t, 2>("110")  == 6);
     static_assert(advent::to_integral<std::int8_t,  2>("-110") == -6);
 
+    static_assert(advent::to_integral<std::uint64_t>("12345678")             == 12345678);
+    static_assert(advent::to_integral<std::uint64_t>("1234567890123")        == 1234567890123);
+    static_assert(advent::to_integral<std::int64_t>("-9223372036854775807")  == -9223372036854775807);
+    static_assert(advent::to_integral<std::uint64_t>("18446744073709551615") == 18446744073709551615u);
+    static_assert(advent::to_integral<std::uint8_t>("00000000012")           == 12);
+
+    /* Ranges which aren't contiguous go through the generic path. */
+    static_assert(advent::to_integral<std::size_t>(std::string_view("4321") | std::views::reverse) == 1234);
+    static_assert(advent::to_integral<std::int32_t>(std::string_view("002x0-") | std::views::reverse) == -0x200);
+
     export template<std::integral Num, std::integral Base>
     constexpr Num count_digits(Num num, const Base base) {
         Num num_digits = 0;
@@ -0,0 +1,19 @@
+#pragma once
+
+/*
+    Included before everything else in a day which is built with
+    its real input embedded, so that the day may be solved entirely
+    during constant evaluation. See 'add_day' in our 'CMakeLists.txt'.
+
+    NOTE: We're included before 'import std;', and so only
+    declare a plain array, which 'advent' finds by its name.
+*/
+
+#ifdef ADVENT_EMBEDDED_INPUT
+
+/* NOTE: We add our own null terminator so that an empty input is still a valid array. */
+constexpr inline char advent_embedded_input[] = {
+    #embed ADVENT_EMBEDDED_INPUT suffix(,) '\0'
+};
+
+#endif
@@ -0,0 +1,419 @@
+#include <advent/defines.hpp>
+
+export module advent:flat_hash_map;
+
+import std;
+
+namespace advent {
+
+    namespace impl {
+
+        /* The finalizer of SplitMix64, so that even sequential keys spread across our low bits. */
+        constexpr std::uint64_t mix_hash(std::uint64_t value) {
+            value ^= value >> 30;
+            value *= 0xBF58476D1CE4E5B9;
+            value ^= value >> 27;
+            value *= 0x94D049BB133111EB;
+            value ^= value >> 31;
+
+            return value;
+        }
+
+        constexpr std::uint64_t combine_hashes(const std::uint64_t seed, const std::uint64_t hash) {
+            return seed ^ (hash + 0x9E3779B97F4A7C15 + (seed << 6) + (seed >> 2));
+        }
+
+        template<typename T>
+        concept tuple_like = requires {
+            std::tuple_size<T>::value;
+        };
+
+    }
+
+    /*
+        Since 'std::hash' may not be used during constant evaluation,
+        this hashes integers, enums, strings, and ranges and tuples
+        of those, whether during constant evaluation or not.
+    */
+    export struct hash {
+        template<typename T>
+        static constexpr std::uint64_t operator ()(const T &value) {
+            if constexpr (std::integral<T> || std::is_enum_v<T>) {
+                return impl::mix_hash(static_cast<std::uint64_t>(value));
+            } else if constexpr (std::convertible_to<const T &, std::string_view>) {
+                /* FNV-1a, mixed further since its low bits are weak. */
+                std::uint64_t hash = 0xCBF29CE484222325;
+                for (const auto c : std::string_view(value)) {
+                    hash ^= static_cast<unsigned char>(c);
+                    hash *= 0x100000001B3;
+                }
+
+                return impl::mix_hash(hash);
+            } else if constexpr (std::ranges::input_range<const T>) {
+                std::uint64_t hash = 0;
+                for (const auto &elem : value) {
+                    hash = impl::combine_hashes(hash, advent::hash::operator ()(elem));
+                }
+
+                return hash;
+            } else if constexpr (impl::tuple_like<T>) {
+                return std::apply([](const auto &... elems) {
+                    std::uint64_t hash = 0;
+                    ((hash = impl::combine_hashes(hash, advent::hash::operator ()(elems))), ...);
+
+                    return hash;
+                }, value);
+            } else {
+                static_assert(false, "Unable to hash type");
+            }
+        }
+    };
+
+    static_assert(advent::hash{}(1) != advent::hash{}(2));
+    static_assert(advent::hash{}(std::string_view("ab")) != advent::hash{}(std::string_view("ba")));
+    static_assert(advent::hash{}(std::pair(1, 2)) != advent::hash{}(std::pair(2, 1)));
+
+    namespace impl {
+
+        struct key_of_pair {
+            template<typename Pair>
+            static constexpr auto &operator ()(Pair &pair) {
+                return pair.first;
+            }
+        };
+
+        /*
+            The table shared by 'advent::flat_hash_map' and 'advent::flat_hash_set'.
+
+            Elements live inline in a single array whose size is a power of two,
+            and a key is found by probing linearly from where its hash lands,
+            so that a lookup usually touches only one or two cache lines.
+
+            NOTE: Erasing shifts later elements of the same run back,
+            rather than leaving tombstones, so lookups never slow down.
+        */
+        template<typename Key, typename Value, typename KeyOf, typename Hash, typename KeyEqual>
+        struct flat_hash_table {
+            using key_type   = Key;
+            using value_type = Value;
+            using size_type  = std::size_t;
+
+            static constexpr size_type MinCapacity = 16;
+
+            template<bool IsConst>
+            struct basic_iterator {
+                using iterator_concept = std::forward_iterator_tag;
+                using value_type       = std::remove_cv_t<Value>;
+                using difference_type  = std::ptrdiff_t;
+
+                using slot_pointer = std::conditional_t<IsConst, const std::optional<Value> *, std::optional<Value> *>;
+                using reference    = std::conditional_t<IsConst, const Value &, Value &>;
+                using pointer      = std::conditional_t<IsConst, const Value *, Value *>;
+
+                slot_pointer _slot = nullptr;
+                slot_pointer _end  = nullptr;
+
+                constexpr void _skip_empty(this basic_iterator &self) {
+                    while (self._slot != self._end && not self._slot->has_value()) {
+                        ++self._slot;
+                    }
+                }
+
+                constexpr reference operator *(this const basic_iterator &self) {
+                    return **self._slot;
+                }
+
+                constexpr pointer operator ->(this const basic_iterator &self) {
+                    return std::addressof(**self._slot);
+                }
+
+                constexpr basic_iterator &operator ++(this basic_iterator &self) {
+                    ++self._slot;
+                    self._skip_empty();
+
+                    return self;
+                }
+
+                constexpr ADVENT_RIGHT_UNARY_OP_FROM_LEFT(basic_iterator, ++)
+
+                constexpr operator basic_iterator<true>(this const basic_iterator &self) requires (!IsConst) {
+                    return basic_iterator<true>{self._slot, self._end};
+                }
+
+                friend constexpr bool operator ==(const basic_iterator &lhs, const basic_iterator &rhs) {
+                    return lhs._slot == rhs._slot;
+                }
+            };
+
+            using iterator       = basic_iterator<false>;
+            using const_iterator = basic_iterator<true>;
+
+            std::vector<std::optional<Value>> _slots;
+            size_type                         _size = 0;
+
+            [[no_unique_address]] Hash     _hash     = {};
+            [[no_unique_address]] KeyEqual _key_equal = {};
+
+            constexpr flat_hash_table() = default;
+
+            constexpr explicit flat_hash_table(const size_type expected_size) {
+                this->reserve(expected_size);
+            }
+
+            static constexpr const Key &_key_of(const Value &value) {
+                return KeyOf{}(value);
+            }
+
+            constexpr size_type _mask(this const flat_hash_table &self) {
+                return self._slots.size() - 1;
+            }
+
+            template<typename K>
+            constexpr size_type _home_of(this const flat_hash_table &self, const K &key) {
+                return static_cast<size_type>(std::invoke(self._hash, key)) & self._mask();
+            }
+
+            /* The index of the slot holding 'key', or else of the empty slot where it would go. */
+            template<typename K>
+            constexpr size_type _probe(this const flat_hash_table &self, const K &key) {
+                [[assume(!self._slots.empty())]];
+
+                auto index = self._home_of(key);
+                while (self._slots[index].has_value() && not std::invoke(self._key_equal, _key_of(*self._slots[index]), key)) {
+                    index = (index + 1) & self._mask();
+                }
+
+                return index;
+            }
+
+            constexpr void _rehash(this flat_hash_table &self, const size_type new_capacity) {
+                [[assume(std::has_single_bit(new_capacity))]];
+
+                auto old_slots = std::exchange(self._slots, std::vector<std::optional<Value>>(new_capacity));
+
+                for (auto &slot : old_slots) {
+                    if (slot.has_value()) {
+                        self._slots[self._probe(_key_of(*slot))].emplace(std::move(*slot));
+                    }
+                }
+            }
+
+            /* NOTE: We grow once more than three quarters full, as linear probing degrades quickly past that. */
+            constexpr void _grow_for(this flat_hash_table &self, const size_type num_elements) {
+                if (num_elements * 4 <= self._slots.size() * 3) {
+                    return;
+                }
+
+                self._rehash(std::bit_ceil(std::max(MinCapacity, (num_elements * 4 + 2) / 3)));
+            }
+
+            constexpr void reserve(this flat_hash_table &self, const size_type num_elements) {
+                self._grow_for(num_elements);
+            }
+
+            constexpr size_type size(this const flat_hash_table &self) {
+                return self._size;
+            }
+
+            constexpr bool empty(this const flat_hash_table &self) {
+                return self._size <= 0;
+            }
+
+            constexpr size_type capacity(this const flat_hash_table &self) {
+                return self._slots.size();
+            }
+
+            constexpr void clear(this flat_hash_table &self) {
+                for (auto &slot : self._slots) {
+                    slot.reset();
+                }
+
+                self._size = 0;
+            }
+
+            constexpr iterator begin(this flat_hash_table &self) {
+                auto it = iterator{self._slots.data(), self._slots.data() + self._slots.size()};
+                it._skip_empty();
+
+                return it;
+            }
+
+            constexpr const_iterator begin(this const flat_hash_table &self) {
+                auto it = const_iterator{self._slots.data(), self._slots.data() + self._slots.size()};
+                it._skip_empty();
+
+                return it;
+            }
+
+            constexpr iterator end(this flat_hash_table &self) {
+                return iterator{self._slots.data() + self._slots.size(), self._slots.data() + self._slots.size()};
+            }
+
+            constexpr const_iterator end(this const flat_hash_table &self) {
+                return const_iterator{self._slots.data() + self._slots.size(), self._slots.data() + self._slots.size()};
+            }
+
+            template<typename K = Key>
+            constexpr auto find(this auto &self, const K &key) {
+                if (self._slots.empty()) {
+                    return self.end();
+                }
+
+                const auto index = self._probe(key);
+                if (not self._slots[index].has_value()) {
+                    return self.end();
+                }
+
+                return decltype(self.end()){self._slots.data() + index, self._slots.data() + self._slots.size()};
+            }
+
+            template<typename K = Key>
+            constexpr bool contains(this const flat_hash_table &self, const K &key) {
+                return self.find(key) != self.end();
+            }
+
+            /*
+                Places the element made from 'args' at the slot for
+                'key', should 'key' not already be present, returning
+                that element and whether it was newly placed there.
+            */
+            template<typename K, typename... Args>
+            constexpr std::pair<iterator, bool> _emplace_at_key(this flat_hash_table &self, const K &key, Args &&... args) {
+                self._grow_for(self._size + 1);
+
+                const auto index = self._probe(key);
+                auto &slot = self._slots[index];
+
+                const auto inserted = not slot.has_value();
+                if (inserted) {
+                    slot.emplace(std::forward<Args>(args)...);
+
+                    ++self._size;
+                }
+
+                return {iterator{std::addressof(slot), self._slots.data() + self._slots.size()}, inserted};
+            }
+
+            template<typename K = Key>
+            constexpr size_type erase(this flat_hash_table &self, const K &key) {
+                if (self._slots.empty()) {
+                    return 0;
+                }
+
+                auto hole = self._probe(key);
+                if (not self._slots[hole].has_value()) {
+                    return 0;
+                }
+
+                self._slots[hole].reset();
+                --self._size;
+
+                /* Shift back anything after us in this run which would otherwise no longer be found. */
+                for (auto index = (hole + 1) & self._mask(); self._slots[index].has_value(); index = (index + 1) & self._mask()) {
+                    const auto home = self._home_of(_key_of(*self._slots[index]));
+
+                    /* Whether 'home' lies cyclically within '(hole, index]', in which case it can stay. */
+                    const auto can_stay = (hole <= index) ? (hole < home && home <= index) : (hole < home || home <= index);
+                    if (can_stay) {
+                        continue;
+                    }
+
+                    self._slots[hole].emplace(std::move(*self._slots[index]));
+                    self._slots[index].reset();
+
+                    hole = index;
+                }
+
+                return 1;
+            }
+        };
+
+    }
+
+    /*
+        A hash map which, unlike 'std::unordered_map', may be used
+        during constant evaluation, and which keeps its elements
+        inline in one array rather than allocating each of them.
+
+        NOTE: Inserting may move every element, invalidating
+        any iterators and references into the map.
+    */
+    export template<typename Key, typename Value, typename Hash = advent::hash, typename KeyEqual = std::equal_to<>>
+    struct flat_hash_map : impl::flat_hash_table<Key, std::pair<const Key, Value>, impl::key_of_pair, Hash, KeyEqual> {
+        using mapped_type = Value;
+
+        using impl::flat_hash_table<Key, std::pair<const Key, Value>, impl::key_of_pair, Hash, KeyEqual>::flat_hash_table;
+
+        template<typename... Args>
+        constexpr auto try_emplace(this flat_hash_map &self, const Key &key, Args &&... args) {
+            return self._emplace_at_key(key, std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Args>(args)...));
+        }
+
+        constexpr auto insert(this flat_hash_map &self, const std::pair<const Key, Value> &value) {
+            return self._emplace_at_key(value.first, value);
+        }
+
+        template<typename V>
+        constexpr auto insert_or_assign(this flat_hash_map &self, const Key &key, V &&value) {
+            auto result = self.try_emplace(key, std::forward<V>(value));
+            if (not result.second) {
+                result.first->second = std::forward<V>(value);
+            }
+
+            return result;
+        }
+
+        constexpr Value &operator [](this flat_hash_map &self, const Key &key) {
+            return self.try_emplace(key).first->second;
+        }
+    };
+
+    /* The set counterpart to 'advent::flat_hash_map', whose elements may not be modified in place. */
+    export template<typename Key, typename Hash = advent::hash, typename KeyEqual = std::equal_to<>>
+    struct flat_hash_set : impl::flat_hash_table<Key, const Key, std::identity, Hash, KeyEqual> {
+        using impl::flat_hash_table<Key, const Key, std::identity, Hash, KeyEqual>::flat_hash_table;
+
+        template<typename K>
+        requires (std::constructible_from<Key, K>)
+        constexpr auto insert(this flat_hash_set &self, K &&key) {
+            return self._emplace_at_key(key, std::forward<K>(key));
+        }
+    };
+
+    static_assert(std::ranges::forward_range<flat_hash_map<int, int>>);
+    static_assert(std::ranges::forward_range<flat_hash_set<int>>);
+
+    static_assert([]() {
+        auto map = advent::flat_hash_map<std::string_view, int>();
+
+        map["one"]   = 1;
+        map["two"]   = 2;
+        map["three"] = 3;
+
+        map["two"] += 20;
+
+        return map.size() == 3 && map.find("two")->second == 22 && not map.contains("four");
+    }());
+
+    static_assert([]() {
+        /* Enough to grow a few times, and to erase from the middle of runs. */
+        auto set = advent::flat_hash_set<std::size_t>();
+
+        for (const auto i : std::views::iota(0uz, 1000uz)) {
+            set.insert(i * 7);
+        }
+
+        for (const auto i : std::views::iota(0uz, 1000uz) | std::views::filter([](const auto i) { return i % 2 == 0; })) {
+            set.erase(i * 7);
+        }
+
+        for (const auto i : std::views::iota(0uz, 1000uz)) {
+            if (set.contains(i * 7) != (i % 2 != 0)) {
+                return false;
+            }
+        }
+
+        return set.size() == 500 && std::ranges::distance(set.begin(), set.end()) == 500;
+    }());
+
+}
@@ -0,0 +1,378 @@
+export module advent:flat_map;
+
+import std;
+
+namespace advent {
+
+    namespace impl {
+
+        /*
+            The index of the first of 'keys' not ordered before 'key'.
+
+            NOTE: Rather than branching on each comparison, which
+            is as likely as not to be mispredicted, we only ever
+            select how far to step, which compiles to a 'cmov'.
+        */
+        template<typename Key, typename K, typename Compare>
+        constexpr std::size_t branchless_lower_bound(const std::span<const Key> keys, const K &key, const Compare &comp) {
+            if (keys.empty()) {
+                return 0;
+            }
+
+            std::size_t first  = 0;
+            std::size_t length = keys.size();
+
+            while (length > 1) {
+                const auto half = length / 2;
+
+                first  += std::invoke(comp, keys[first + half], key) ? half : 0uz;
+                length -= half;
+            }
+
+            return first + (std::invoke(comp, keys[first], key) ? 1uz : 0uz);
+        }
+
+        static_assert(impl::branchless_lower_bound(std::span<const int>{}, 1, std::less{}) == 0);
+
+        static_assert([]() {
+            constexpr auto keys = std::array{1, 3, 3, 5, 7, 9, 11};
+
+            for (const auto key : std::views::iota(0, 13)) {
+                if (impl::branchless_lower_bound(std::span<const int>(keys), key, std::less{}) != static_cast<std::size_t>(std::ranges::lower_bound(keys, key) - keys.begin())) {
+                    return false;
+                }
+            }
+
+            return true;
+        }());
+
+        /*
+            The indices of 'keys' in sorted order, keeping only
+            the first given of any equal keys, so that we sort
+            just once, rather than inserting keys one by one.
+        */
+        template<typename Key, typename Compare>
+        constexpr std::vector<std::size_t> sorted_unique_order(const std::span<const Key> keys, const Compare &comp) {
+            auto order = std::vector<std::size_t>(std::from_range, std::views::iota(0uz, keys.size()));
+
+            /* NOTE: Equal keys are ordered by index so that we needn't rely on a stable sort. */
+            std::ranges::sort(order, [&](const std::size_t lhs, const std::size_t rhs) {
+                if (std::invoke(comp, keys[lhs], keys[rhs])) {
+                    return true;
+                }
+
+                if (std::invoke(comp, keys[rhs], keys[lhs])) {
+                    return false;
+                }
+
+                return lhs < rhs;
+            });
+
+            const auto duplicates = std::ranges::unique(order, [&](const std::size_t lhs, const std::size_t rhs) {
+                return not std::invoke(comp, keys[lhs], keys[rhs]) && not std::invoke(comp, keys[rhs], keys[lhs]);
+            });
+
+            order.erase(duplicates.begin(), duplicates.end());
+
+            return order;
+        }
+
+        template<typename T>
+        constexpr std::vector<T> permuted(std::vector<T> &elems, const std::span<const std::size_t> order) {
+            std::vector<T> result;
+            result.reserve(order.size());
+
+            for (const auto index : order) {
+                result.push_back(std::move(elems[index]));
+            }
+
+            return result;
+        }
+
+        /*
+            Looks up each of 'queries' within the sorted 'keys' with a single
+            merge pass over both, calling 'on_found' with the index of each
+            query which was found, along with the index of its key.
+
+            Once sorted, each lookup picks up where the last left off,
+            so that many lookups walk forward through 'keys' only once.
+        */
+        template<typename Key, std::ranges::random_access_range R, typename Compare, typename OnFound>
+        requires (std::ranges::sized_range<R> && std::invocable<OnFound &, std::size_t, std::size_t>)
+        constexpr void merge_lookup(const std::span<const Key> keys, R &&queries, const Compare &comp, OnFound &&on_found) {
+            auto query_order = std::vector<std::size_t>(std::from_range, std::views::iota(0uz, static_cast<std::size_t>(std::ranges::size(queries))));
+
+            std::ranges::sort(query_order, [&](const std::size_t lhs, const std::size_t rhs) {
+                return std::invoke(comp, queries[lhs], queries[rhs]);
+            });
+
+            std::size_t key_index = 0;
+            for (const auto query_index : query_order) {
+                const auto &query = queries[query_index];
+
+                while (key_index < keys.size() && std::invoke(comp, keys[key_index], query)) {
+                    ++key_index;
+                }
+
+                if (key_index >= keys.size()) {
+                    return;
+                }
+
+                if (not std::invoke(comp, query, keys[key_index])) {
+                    std::invoke(on_found, query_index, key_index);
+                }
+            }
+        }
+
+    }
+
+    /*
+        A map which keeps its keys sorted in one array and its values in
+        another, like 'std::flat_map', but which we may use during constant
+        evaluation, and with lookups meant for maps which are built all at
+        once and then only read from.
+
+        NOTE: Since the keys are contiguous, lookups stay within
+        a handful of cache lines, and they never allocate.
+    */
+    export template<typename Key, typename Value, typename Compare = std::less<>>
+    struct flat_map {
+        using key_type    = Key;
+        using mapped_type = Value;
+        using size_type   = std::size_t;
+
+        std::vector<Key>   _keys;
+        std::vector<Value> _values;
+
+        [[no_unique_address]] Compare _comp = {};
+
+        constexpr flat_map() = default;
+
+        /* Builds the map from keys and their values in any order, keeping the first value given for any duplicate key. */
+        constexpr flat_map(std::vector<Key> keys, std::vector<Value> values, const Compare comp = {}) : _comp(comp) {
+            [[assume(keys.size() == values.size())]];
+
+            const auto order = impl::sorted_unique_order(std::span<const Key>(keys), this->_comp);
+
+            this->_keys   = impl::permuted(keys,   order);
+            this->_values = impl::permuted(values, order);
+        }
+
+        /* Builds the map from keys which are already sorted and unique. */
+        constexpr flat_map(std::sorted_unique_t, std::vector<Key> keys, std::vector<Value> values, const Compare comp = {})
+        :
+            _keys(std::move(keys)),
+            _values(std::move(values)),
+            _comp(comp)
+        {
+            [[assume(this->_keys.size() == this->_values.size())]];
+        }
+
+        constexpr size_type size(this const flat_map &self) {
+            return self._keys.size();
+        }
+
+        constexpr bool empty(this const flat_map &self) {
+            return self._keys.empty();
+        }
+
+        constexpr std::span<const Key> keys(this const flat_map &self) {
+            return self._keys;
+        }
+
+        constexpr std::span<const Value> values(this const flat_map &self) {
+            return self._values;
+        }
+
+        constexpr std::span<Value> values(this flat_map &self) {
+            return self._values;
+        }
+
+        template<typename K = Key>
+        constexpr size_type lower_bound(this const flat_map &self, const K &key) {
+            return impl::branchless_lower_bound(self.keys(), key, self._comp);
+        }
+
+        /* The index of 'key' within 'keys' and 'values', if present. */
+        template<typename K = Key>
+        constexpr std::optional<size_type> index_of(this const flat_map &self, const K &key) {
+            const auto index = self.lower_bound(key);
+            if (index >= self.size() || std::invoke(self._comp, key, self._keys[index])) {
+                return std::nullopt;
+            }
+
+            return index;
+        }
+
+        template<typename K = Key>
+        constexpr bool contains(this const flat_map &self, const K &key) {
+            return self.index_of(key).has_value();
+        }
+
+        template<typename K = Key>
+        constexpr auto find(this auto &self, const K &key) -> decltype(std::addressof(self._values[0])) {
+            const auto index = self.index_of(key);
+            if (not index.has_value()) {
+                return nullptr;
+            }
+
+            return std::addressof(self._values[*index]);
+        }
+
+        /*
+            Looks up every one of 'queries' at once, giving back the value
+            of each in the same order, or 'std::nullopt' for those not found.
+
+            This sorts the queries and then merges them with our keys, which
+            beats a binary search for each once there are a lot of them.
+        */
+        template<std::ranges::random_access_range R>
+        requires (std::ranges::sized_range<R>)
+        constexpr std::vector<std::optional<Value>> find_each(this const flat_map &self, R &&queries) {
+            auto found = std::vector<std::optional<Value>>(static_cast<std::size_t>(std::ranges::size(queries)));
+
+            impl::merge_lookup(self.keys(), queries, self._comp, [&](const std::size_t query_index, const std::size_t key_index) {
+                found[query_index] = self._values[key_index];
+            });
+
+            return found;
+        }
+
+        /*
+            Inserts the value made from 'args' for 'key' should 'key' not
+            be present, returning its index and whether it was inserted.
+
+            NOTE: This must move every later element, and so is best
+            avoided in favor of building the whole map at once.
+        */
+        template<typename... Args>
+        constexpr std::pair<size_type, bool> try_emplace(this flat_map &self, const Key &key, Args &&... args) {
+            const auto index = self.lower_bound(key);
+            if (index < self.size() && not std::invoke(self._comp, key, self._keys[index])) {
+                return {index, false};
+            }
+
+            self._keys.insert(self._keys.begin() + static_cast<std::ptrdiff_t>(index), key);
+            self._values.emplace(self._values.begin() + static_cast<std::ptrdiff_t>(index), std::forward<Args>(args)...);
+
+            return {index, true};
+        }
+    };
+
+    /* The set counterpart to 'advent::flat_map'. */
+    export template<typename Key, typename Compare = std::less<>>
+    struct flat_set {
+        using key_type  = Key;
+        using size_type = std::size_t;
+
+        std::vector<Key> _keys;
+
+        [[no_unique_address]] Compare _comp = {};
+
+        constexpr flat_set() = default;
+
+        /* Builds the set from keys in any order, dropping duplicates. */
+        constexpr explicit flat_set(std::vector<Key> keys, const Compare comp = {}) : _comp(comp) {
+            const auto order = impl::sorted_unique_order(std::span<const Key>(keys), this->_comp);
+
+            this->_keys = impl::permuted(keys, order);
+        }
+
+        /* Builds the set from keys which are already sorted and unique. */
+        constexpr flat_set(std::sorted_unique_t, std::vector<Key> keys, const Compare comp = {})
+            : _keys(std::move(keys)), _comp(comp) { }
+
+        constexpr size_type size(this const flat_set &self) {
+            return self._keys.size();
+        }
+
+        constexpr bool empty(this const flat_set &self) {
+            return self._keys.empty();
+        }
+
+        constexpr auto begin(this const flat_set &self) {
+            return self._keys.cbegin();
+        }
+
+        constexpr auto end(this const flat_set &self) {
+            return self._keys.cend();
+        }
+
+        constexpr const Key &operator [](this const flat_set &self, const size_type index) {
+            [[assume(index < self.size())]];
+
+            return self._keys[index];
+        }
+
+        template<typename K = Key>
+        constexpr size_type lower_bound(this const flat_set &self, const K &key) {
+            return impl::branchless_lower_bound(std::span<const Key>(self._keys), key, self._comp);
+        }
+
+        /* The index of 'key' within the set, if present. */
+        template<typename K = Key>
+        constexpr std::optional<size_type> index_of(this const flat_set &self, const K &key) {
+            const auto index = self.lower_bound(key);
+            if (index >= self.size() || std::invoke(self._comp, key, self._keys[index])) {
+                return std::nullopt;
+            }
+
+            return index;
+        }
+
+        template<typename K = Key>
+        constexpr bool contains(this const flat_set &self, const K &key) {
+            return self.index_of(key).has_value();
+        }
+
+        /* Looks up the index of every one of 'queries' at once, as 'advent::flat_map::find_each' does. */
+        template<std::ranges::random_access_range R>
+        requires (std::ranges::sized_range<R>)
+        constexpr std::vector<std::optional<size_type>> index_of_each(this const flat_set &self, R &&queries) {
+            auto found = std::vector<std::optional<size_type>>(static_cast<std::size_t>(std::ranges::size(queries)));
+
+            impl::merge_lookup(std::span<const Key>(self._keys), queries, self._comp, [&](const std::size_t query_index, const std::size_t key_index) {
+                found[query_index] = key_index;
+            });
+
+            return found;
+        }
+
+        /* Inserts 'key' should it not be present, returning its index and whether it was inserted. */
+        constexpr std::pair<size_type, bool> insert(this flat_set &self, const Key &key) {
+            const auto index = self.lower_bound(key);
+            if (index < self.size() && not std::invoke(self._comp, key, self._keys[index])) {
+                return {index, false};
+            }
+
+            self._keys.insert(self._keys.begin() + static_cast<std::ptrdiff_t>(index), key);
+
+            return {index, true};
+        }
+    };
+
+    static_assert(std::ranges::random_access_range<flat_set<int>>);
+
+    static_assert([]() {
+        const auto map = advent::flat_map<std::string_view, int>({"c", "a", "b", "a"}, {3, 1, 2, 4});
+
+        return (
+            map.size() == 3                                                                           &&
+            std::ranges::equal(map.keys(), std::array<std::string_view, 3>{"a", "b", "c"})            &&
+            *map.find("a") == 1                                                                       &&
+            map.find("d") == nullptr                                                                  &&
+            map.find_each(std::array<std::string_view, 4>{"c", "d", "a", "c"}) == std::vector<std::optional<int>>{3, std::nullopt, 1, 3}
+        );
+    }());
+
+    static_assert([]() {
+        auto set = advent::flat_set<int>({5, 1, 3, 1});
+        set.insert(2);
+
+        return (
+            std::ranges::equal(set, std::array{1, 2, 3, 5})                                                     &&
+            set.index_of_each(std::array{5, 4, 1}) == std::vector<std::optional<std::size_t>>{3, std::nullopt, 0}
+        );
+    }());
+
+}
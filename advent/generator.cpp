@@ -0,0 +1,109 @@
+export module advent:generator;
+
+import std;
+
+import :print;
+
+namespace advent {
+
+    /*
+        The options a day's input generator may be run with.
+
+        What 'scale' means is up to each generator, such as
+        the number of lines or the side length of a grid.
+    */
+    export struct generator_options {
+        static constexpr std::string_view Usage = "<scale> [--seed <seed>]";
+
+        std::size_t   scale = 0;
+        std::uint64_t seed  = 0;
+    };
+
+    /* 'argv' is a pointer to a const pointer to a const 'char'. */
+    export constexpr auto parse_generator_options(int argc, const char * const *argv) -> std::optional<advent::generator_options> {
+        const auto parse_number = [](const std::string_view arg) -> std::optional<std::uint64_t> {
+            std::uint64_t number;
+
+            const auto [end, error] = std::from_chars(arg.data(), arg.data() + arg.size(), number);
+            if (error != std::errc() || end != arg.data() + arg.size()) {
+                return std::nullopt;
+            }
+
+            return number;
+        };
+
+        if (argc < 2) {
+            return std::nullopt;
+        }
+
+        const auto args = std::span(argv, static_cast<std::size_t>(argc));
+
+        advent::generator_options options;
+
+        bool have_scale = false;
+        for (auto it = args.begin() + 1; it < args.end(); ++it) {
+            const auto arg = std::string_view(*it);
+
+            if (arg == "--seed") {
+                ++it;
+                if (it >= args.end()) {
+                    return std::nullopt;
+                }
+
+                const auto seed = parse_number(*it);
+                if (not seed.has_value()) {
+                    return std::nullopt;
+                }
+
+                options.seed = *seed;
+            } else if (not have_scale) {
+                const auto scale = parse_number(arg);
+                if (not scale.has_value() || *scale <= 0) {
+                    return std::nullopt;
+                }
+
+                options.scale = static_cast<std::size_t>(*scale);
+
+                have_scale = true;
+            } else {
+                return std::nullopt;
+            }
+        }
+
+        if (not have_scale) {
+            return std::nullopt;
+        }
+
+        return options;
+    }
+
+    /* A uniformly random integer in '[min, max]'. */
+    export template<std::integral T>
+    auto random_between(std::mt19937_64 &rng, const T min, const T max) -> T {
+        return std::uniform_int_distribution<T>(min, max)(rng);
+    }
+
+    /*
+        Prints the input which 'generate' makes at the requested
+        scale, deterministically so for any given seed.
+    */
+    export template<typename Generate>
+    requires (std::invocable<Generate &, std::size_t, std::mt19937_64 &>)
+    auto generate_input(int argc, const char * const *argv, Generate &&generate) -> int {
+        const auto options = advent::parse_generator_options(argc, argv);
+        if (not options.has_value()) {
+            advent::println("Usage: {} {}", argv[0], advent::generator_options::Usage);
+
+            return 1;
+        }
+
+        auto rng = std::mt19937_64(options->seed);
+
+        const std::string input = std::invoke(generate, options->scale, rng);
+
+        advent::print("{}", input);
+
+        return 0;
+    }
+
+}
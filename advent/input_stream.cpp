@@ -0,0 +1,304 @@
+module;
+
+#include <advent/defines.hpp>
+
+/* NOTE: Needed for 'errno', 'read', 'mmap' and friends. */
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+export module advent:input_stream;
+
+import std;
+
+namespace advent {
+
+    /* The path by which we refer to our standard input. */
+    export constexpr inline std::string_view standard_input_path = "-";
+
+    /* Opens 'path' for reading, where a path of '-' refers to our standard input. */
+    export auto open_input(const char *path) -> int {
+        if (path == advent::standard_input_path) {
+            return ::dup(STDIN_FILENO);
+        }
+
+        return ::open(path, O_RDONLY | O_CLOEXEC);
+    }
+
+    /*
+        Reads everything from 'fd' in large chunks into a growable
+        buffer, and so works with anything we can read from, such
+        as pipes and FIFOs, which we can neither map nor seek.
+    */
+    export auto read_descriptor(const int fd) -> std::optional<std::string> {
+        static constexpr std::size_t ChunkSize = 1uz << 20;
+
+        std::string contents;
+
+        while (true) {
+            const auto old_size = contents.size();
+
+            /* NOTE: Growing by at least the current size keeps this amortized linear. */
+            const auto new_capacity = old_size + std::max(ChunkSize, old_size);
+
+            auto num_read = decltype(::read(fd, nullptr, 0)){};
+            contents.resize_and_overwrite(new_capacity, [&](char *data, const std::size_t) {
+                num_read = ::read(fd, data + old_size, new_capacity - old_size);
+
+                return old_size + static_cast<std::size_t>(std::max(num_read, decltype(num_read){0}));
+            });
+
+            if (num_read < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+
+                return std::nullopt;
+            }
+
+            if (num_read == 0) {
+                return contents;
+            }
+        }
+    }
+
+    /*
+        Input which is read while it is still being solved, such
+        as when piping in input as it is generated, so that its
+        producer and our solver may work at the same time.
+
+        We reserve a large range of address space up front and
+        read into it as needed, so that what we've read never
+        moves and any 'std::string_view' into it stays valid.
+    */
+    export struct input_stream {
+        /* NOTE: Pages are only committed as we fill them. */
+        static constexpr std::size_t MaxReservedSize = 1uz << 36;
+        static constexpr std::size_t MinReservedSize = 1uz << 24;
+        static constexpr std::size_t ChunkSize       = 1uz << 16;
+
+        int _fd = -1;
+
+        char        *_data          = nullptr;
+        std::size_t  _size          = 0;
+        std::size_t  _reserved_size = 0;
+
+        bool _finished = false;
+        bool _failed   = false;
+
+        /*
+            Splits what we've read into lines, reading more
+            only once we need to find where a line ends.
+
+            This splits exactly as 'advent::views::split_lines' would.
+        */
+        struct lines_view : std::ranges::view_interface<lines_view> {
+            struct iterator {
+                using iterator_category = std::forward_iterator_tag;
+                using iterator_concept  = std::forward_iterator_tag;
+
+                using difference_type = std::ptrdiff_t;
+
+                using value_type = std::string_view;
+                using reference  = std::string_view;
+
+                input_stream *_stream = nullptr;
+
+                std::size_t _start              = std::string_view::npos;
+                std::size_t _next_delimiter_pos = std::string_view::npos;
+
+                iterator() = default;
+
+                explicit iterator(input_stream &stream)
+                :
+                    _stream(&stream),
+                    _start(0),
+                    _next_delimiter_pos(stream._find_newline(0))
+                {}
+
+                iterator &operator ++() {
+                    if (this->_next_delimiter_pos != std::string_view::npos) {
+                        this->_start              = this->_next_delimiter_pos + 1;
+                        this->_next_delimiter_pos = this->_stream->_find_newline(this->_start);
+                    } else {
+                        this->_start = std::string_view::npos;
+                    }
+
+                    return *this;
+                }
+
+                ADVENT_RIGHT_UNARY_OP_FROM_LEFT(iterator, ++)
+
+                reference operator *() const {
+                    /* NOTE: Without a following newline, we've read everything there is. */
+                    const auto end = (this->_next_delimiter_pos != std::string_view::npos) ?
+                        this->_next_delimiter_pos : this->_stream->_size;
+
+                    return std::string_view(this->_stream->_data + this->_start, end - this->_start);
+                }
+
+                bool operator ==(const iterator &rhs) const {
+                    return this->_start == rhs._start;
+                }
+
+                bool operator ==(std::default_sentinel_t) const {
+                    return this->_start == std::string_view::npos;
+                }
+            };
+
+            input_stream *_stream = nullptr;
+
+            lines_view() = default;
+
+            explicit lines_view(input_stream &stream) : _stream(&stream) {}
+
+            iterator begin() const {
+                return iterator(*this->_stream);
+            }
+
+            std::default_sentinel_t end() const {
+                return std::default_sentinel;
+            }
+        };
+
+        input_stream() = default;
+
+        input_stream(input_stream &&other)
+        :
+            _fd(std::exchange(other._fd, -1)),
+            _data(std::exchange(other._data, nullptr)),
+            _size(std::exchange(other._size, 0)),
+            _reserved_size(std::exchange(other._reserved_size, 0)),
+            _finished(other._finished),
+            _failed(other._failed)
+        {}
+
+        input_stream &operator =(input_stream &&) = delete;
+
+        input_stream(const input_stream &) = delete;
+        input_stream &operator =(const input_stream &) = delete;
+
+        ~input_stream() {
+            if (this->_data != nullptr) {
+                ::munmap(this->_data, this->_reserved_size);
+            }
+
+            if (this->_fd >= 0) {
+                ::close(this->_fd);
+            }
+        }
+
+        static auto open(const char *path) -> std::optional<input_stream> {
+            input_stream stream;
+
+            stream._fd = advent::open_input(path);
+            if (stream._fd < 0) {
+                return std::nullopt;
+            }
+
+            /*
+                NOTE: Even address space we never touch counts against
+                'ulimit -v', and against strict overcommit, which ignores
+                'MAP_NORESERVE', so we make do with less when we must.
+            */
+            for (auto reserved_size = MaxReservedSize; reserved_size >= MinReservedSize; reserved_size /= 2) {
+                const auto mapping = ::mmap(nullptr, reserved_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+                if (mapping == MAP_FAILED) {
+                    continue;
+                }
+
+                stream._data          = static_cast<char *>(mapping);
+                stream._reserved_size = reserved_size;
+
+                return stream;
+            }
+
+            return std::nullopt;
+        }
+
+        /* Reads the next chunk, returning whether there was anything left to read. */
+        auto _read_more(this input_stream &self) -> bool {
+            while (not self._finished) {
+                const auto to_read = std::min(ChunkSize, self._reserved_size - self._size);
+                if (to_read <= 0) {
+                    /* We've run out of room, and so can't read the rest. */
+                    self._failed   = true;
+                    self._finished = true;
+
+                    return false;
+                }
+
+                const auto num_read = ::read(self._fd, self._data + self._size, to_read);
+                if (num_read < 0) {
+                    if (errno == EINTR) {
+                        continue;
+                    }
+
+                    self._failed   = true;
+                    self._finished = true;
+
+                    return false;
+                }
+
+                if (num_read == 0) {
+                    self._finished = true;
+
+                    return false;
+                }
+
+                self._size += static_cast<std::size_t>(num_read);
+
+                return true;
+            }
+
+            return false;
+        }
+
+        /*
+            Finds the next newline at or after 'pos', reading more as needed,
+            and returns 'std::string_view::npos' only once everything is read.
+        */
+        auto _find_newline(this input_stream &self, std::size_t pos) -> std::size_t {
+            while (true) {
+                const auto read_so_far = std::string_view(self._data, self._size);
+
+                const auto newline_pos = read_so_far.find('\n', pos);
+                if (newline_pos != std::string_view::npos) {
+                    return newline_pos;
+                }
+
+                pos = self._size;
+
+                if (not self._read_more()) {
+                    return std::string_view::npos;
+                }
+            }
+        }
+
+        auto read_to_end(this input_stream &self) -> void {
+            while (self._read_more()) {}
+        }
+
+        auto lines(this input_stream &self) -> lines_view {
+            return lines_view(self);
+        }
+
+        auto failed(this const input_stream &self) -> bool {
+            return self._failed;
+        }
+
+        /* Everything we've read so far. */
+        auto view(this const input_stream &self) -> std::string_view {
+            return std::string_view(self._data, self._size);
+        }
+
+        auto size(this const input_stream &self) -> std::size_t {
+            return self._size;
+        }
+    };
+
+    static_assert(std::ranges::forward_range<input_stream::lines_view>);
+    static_assert(std::ranges::view<input_stream::lines_view>);
+
+}
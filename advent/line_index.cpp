@@ -0,0 +1,277 @@
+module;
+
+#include <advent/defines.hpp>
+
+/* NOTE: Needed for the SSE2 and AVX2 intrinsics. */
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+export module advent:line_index;
+
+import std;
+
+namespace advent {
+
+    namespace impl {
+
+        constexpr void find_newlines_from(const std::string_view str, std::size_t pos, std::vector<std::size_t> &newlines) {
+            for (; pos < str.size(); ++pos) {
+                if (str[pos] == '\n') {
+                    newlines.push_back(pos);
+                }
+            }
+        }
+
+        #if defined(__x86_64__)
+
+        /* Appends the position of each set bit of 'mask', offset by 'pos'. */
+        inline void append_mask_positions(std::uint32_t mask, const std::size_t pos, std::vector<std::size_t> &newlines) {
+            while (mask != 0) {
+                newlines.push_back(pos + static_cast<std::size_t>(std::countr_zero(mask)));
+
+                /* Clears the lowest set bit. */
+                mask &= mask - 1;
+            }
+        }
+
+        /* Returns how far we scanned, leaving what's left over for the scalar loop. */
+        inline std::size_t find_newlines_sse2(const std::string_view str, std::vector<std::size_t> &newlines) {
+            const auto newline = _mm_set1_epi8('\n');
+
+            std::size_t pos = 0;
+            for (; pos + sizeof(__m128i) <= str.size(); pos += sizeof(__m128i)) {
+                const auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(str.data() + pos));
+
+                impl::append_mask_positions(
+                    static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, newline))),
+
+                    pos, newlines
+                );
+            }
+
+            return pos;
+        }
+
+        [[gnu::target("avx2")]]
+        inline std::size_t find_newlines_avx2(const std::string_view str, std::vector<std::size_t> &newlines) {
+            const auto newline = _mm256_set1_epi8('\n');
+
+            std::size_t pos = 0;
+            for (; pos + sizeof(__m256i) <= str.size(); pos += sizeof(__m256i)) {
+                const auto chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(str.data() + pos));
+
+                impl::append_mask_positions(
+                    static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, newline))),
+
+                    pos, newlines
+                );
+            }
+
+            return pos;
+        }
+
+        inline bool cpu_supports_avx2() {
+            static const bool supported = __builtin_cpu_supports("avx2");
+
+            return supported;
+        }
+
+        #endif
+
+        /*
+            Finds the position of every newline in 'str' with a single pass,
+            comparing 32 or 16 bytes at a time where the CPU allows it.
+
+            NOTE: We don't pass '-march' for our builds, so we
+            check for AVX2 at runtime rather than at compile time.
+        */
+        constexpr std::vector<std::size_t> find_newlines(const std::string_view str) {
+            std::vector<std::size_t> newlines;
+
+            std::size_t scanned = 0;
+
+            if !consteval {
+                #if defined(__x86_64__)
+
+                if (impl::cpu_supports_avx2()) {
+                    scanned = impl::find_newlines_avx2(str, newlines);
+                } else {
+                    scanned = impl::find_newlines_sse2(str, newlines);
+                }
+
+                #endif
+            }
+
+            impl::find_newlines_from(str, scanned, newlines);
+
+            return newlines;
+        }
+
+        static_assert(impl::find_newlines("") == std::vector<std::size_t>{});
+        static_assert(impl::find_newlines("a\nbc\n\nd") == std::vector{1uz, 4uz, 5uz});
+
+        constexpr std::string_view line_at(const std::string_view str, const std::span<const std::size_t> newlines, const std::size_t index) {
+            [[assume(index <= newlines.size())]];
+
+            const auto start = (index == 0) ? 0uz : newlines[index - 1] + 1;
+            const auto end   = (index == newlines.size()) ? str.size() : newlines[index];
+
+            return str.substr(start, end - start);
+        }
+
+    }
+
+    /*
+        The lines of a string, split exactly as 'advent::views::split_lines'
+        would split them, but indexed up front so that they may be counted,
+        indexed and partitioned in constant time, such as when handing out
+        chunks of lines to several threads.
+
+        NOTE: This owns its index of the lines, and so
+        is more expensive to copy than most other views.
+    */
+    export struct indexed_lines : std::ranges::view_interface<indexed_lines> {
+        struct iterator {
+            using iterator_concept = std::random_access_iterator_tag;
+            using value_type       = std::string_view;
+            using difference_type  = std::ptrdiff_t;
+
+            std::string_view                 _str      = {};
+            std::span<const std::size_t>     _newlines = {};
+            std::size_t                      _index    = 0;
+
+            constexpr std::string_view operator *(this const iterator &self) {
+                return impl::line_at(self._str, self._newlines, self._index);
+            }
+
+            constexpr std::string_view operator [](this const iterator &self, const difference_type index) {
+                return *(self + index);
+            }
+
+            constexpr iterator &operator ++(this iterator &self) {
+                ++self._index;
+
+                return self;
+            }
+
+            constexpr ADVENT_RIGHT_UNARY_OP_FROM_LEFT(iterator, ++)
+
+            constexpr iterator &operator --(this iterator &self) {
+                --self._index;
+
+                return self;
+            }
+
+            constexpr ADVENT_RIGHT_UNARY_OP_FROM_LEFT(iterator, --)
+
+            friend constexpr auto operator <=>(const iterator &lhs, const iterator &rhs) {
+                [[assume(lhs._str.data() == rhs._str.data())]];
+
+                return lhs._index <=> rhs._index;
+            }
+
+            friend constexpr bool operator ==(const iterator &lhs, const iterator &rhs) {
+                return (lhs <=> rhs) == 0;
+            }
+
+            friend constexpr difference_type operator -(const iterator &lhs, const iterator &rhs) {
+                return static_cast<difference_type>(lhs._index) - static_cast<difference_type>(rhs._index);
+            }
+
+            constexpr iterator &operator +=(this iterator &self, const difference_type difference) {
+                self._index = static_cast<std::size_t>(static_cast<difference_type>(self._index) + difference);
+
+                return self;
+            }
+
+            constexpr iterator &operator -=(this iterator &self, const difference_type difference) {
+                self += -difference;
+
+                return self;
+            }
+
+            constexpr iterator operator +(this iterator self, const difference_type difference) {
+                /* NOTE: We took 'self' by value. */
+
+                self += difference;
+
+                return self;
+            }
+
+            friend constexpr iterator operator +(const difference_type difference, iterator self) {
+                /* NOTE: We took 'self' by value. */
+
+                self += difference;
+
+                return self;
+            }
+
+            constexpr iterator operator -(this iterator self, const difference_type difference) {
+                /* NOTE: We took 'self' by value. */
+
+                self -= difference;
+
+                return self;
+            }
+        };
+
+        std::string_view         _str;
+        std::vector<std::size_t> _newlines;
+
+        constexpr indexed_lines() = default;
+
+        constexpr explicit indexed_lines(const std::string_view str)
+            : view_interface<indexed_lines>(), _str(str), _newlines(impl::find_newlines(str)) { }
+
+        constexpr std::size_t size(this const indexed_lines &self) {
+            /* NOTE: As with splitting, there's always one more line than there are newlines. */
+            if (self._str.data() == nullptr) {
+                return 0;
+            }
+
+            return self._newlines.size() + 1;
+        }
+
+        constexpr std::string_view operator [](this const indexed_lines &self, const std::size_t index) {
+            [[assume(index < self.size())]];
+
+            return impl::line_at(self._str, self._newlines, index);
+        }
+
+        constexpr iterator begin(this const indexed_lines &self) {
+            return iterator{self._str, self._newlines, 0};
+        }
+
+        constexpr iterator end(this const indexed_lines &self) {
+            return iterator{self._str, self._newlines, self.size()};
+        }
+    };
+
+    static_assert(std::ranges::random_access_range<indexed_lines>);
+    static_assert(std::ranges::sized_range<indexed_lines>);
+    static_assert(std::ranges::view<indexed_lines>);
+
+    static_assert(indexed_lines("ab\n\ncd").size() == 3);
+    static_assert(indexed_lines("ab\n\ncd")[0] == "ab");
+    static_assert(indexed_lines("ab\n\ncd")[1] == "");
+    static_assert(indexed_lines("ab\n\ncd")[2] == "cd");
+    static_assert(indexed_lines("ab\n").size() == 2);
+
+    namespace views {
+
+        namespace impl {
+
+            struct index_lines_adaptor_closure : std::ranges::range_adaptor_closure<index_lines_adaptor_closure> {
+                static constexpr auto operator ()(const std::string_view str) {
+                    return advent::indexed_lines(str);
+                }
+            };
+
+        }
+
+        export constexpr inline auto index_lines = impl::index_lines_adaptor_closure{};
+
+    }
+
+}
@@ -0,0 +1,144 @@
+module;
+
+/* NOTE: Needed for 'mmap' and friends. */
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+export module advent:mapped_file;
+
+import std;
+
+import :scope_guard;
+
+namespace advent {
+
+    /*
+        A read-only view of a regular file's contents
+        mapped directly into our address space.
+
+        This lets us hand solvers a 'std::string_view' over
+        large inputs without ever copying them into a buffer.
+    */
+    export struct mapped_file {
+        const char  *_data = nullptr;
+        std::size_t  _size = 0;
+
+        constexpr mapped_file() = default;
+
+        constexpr mapped_file(const char *data, const std::size_t size) : _data(data), _size(size) {}
+
+        constexpr mapped_file(mapped_file &&other)
+        :
+            _data(std::exchange(other._data, nullptr)),
+            _size(std::exchange(other._size, 0))
+        {}
+
+        constexpr mapped_file &operator =(this mapped_file &self, mapped_file &&other) {
+            if (&self == &other) {
+                return self;
+            }
+
+            self._unmap();
+
+            self._data = std::exchange(other._data, nullptr);
+            self._size = std::exchange(other._size, 0);
+
+            return self;
+        }
+
+        mapped_file(const mapped_file &) = delete;
+        mapped_file &operator =(const mapped_file &) = delete;
+
+        constexpr ~mapped_file() {
+            this->_unmap();
+        }
+
+        constexpr void _unmap(this mapped_file &self) {
+            if (self._data == nullptr) {
+                return;
+            }
+
+            ::munmap(const_cast<char *>(self._data), self._size);
+        }
+
+        /*
+            Returns 'std::nullopt' if the file could not be mapped,
+            which includes when it is not a regular file, such as
+            with pipes. Callers should fall back to reading it then.
+        */
+        static auto map(const char *path) -> std::optional<mapped_file> {
+            const auto fd = ::open(path, O_RDONLY | O_CLOEXEC);
+            if (fd < 0) {
+                return std::nullopt;
+            }
+
+            /* NOTE: The mapping stays valid after its descriptor is closed. */
+            advent::scope_guard _ = [&]() {
+                ::close(fd);
+            };
+
+            return mapped_file::map_descriptor(fd);
+        }
+
+        /* As with 'map', but for an already opened file, which is left open. */
+        static auto map_descriptor(const int fd) -> std::optional<mapped_file> {
+            struct stat info;
+            if (::fstat(fd, &info) < 0) {
+                return std::nullopt;
+            }
+
+            if (not S_ISREG(info.st_mode)) {
+                return std::nullopt;
+            }
+
+            const auto size = static_cast<std::size_t>(info.st_size);
+
+            /* Zero-length mappings are not allowed, but there's nothing to map anyways. */
+            if (size <= 0) {
+                return mapped_file();
+            }
+
+            const auto flags = [&]() {
+                #ifdef MAP_POPULATE
+                    /* Fault every page in up front so solvers don't pay for it while being timed. */
+                    return MAP_PRIVATE | MAP_POPULATE;
+                #else
+                    return MAP_PRIVATE;
+                #endif
+            }();
+
+            const auto mapping = ::mmap(nullptr, size, PROT_READ, flags, fd, 0);
+            if (mapping == MAP_FAILED) {
+                return std::nullopt;
+            }
+
+            /* NOTE: This is only a hint, so we don't care if it fails. */
+            ::madvise(mapping, size, MADV_SEQUENTIAL);
+
+            return mapped_file(static_cast<const char *>(mapping), size);
+        }
+
+        constexpr const char *data(this const mapped_file &self) {
+            return self._data;
+        }
+
+        constexpr std::size_t size(this const mapped_file &self) {
+            return self._size;
+        }
+
+        constexpr std::string_view view(this const mapped_file &self) {
+            if (self._data == nullptr) {
+                return std::string_view();
+            }
+
+            return std::string_view(self._data, self._size);
+        }
+
+        constexpr explicit(false) operator std::string_view(this const mapped_file &self) {
+            return self.view();
+        }
+    };
+
+}
@@ -0,0 +1,297 @@
+export module advent:options;
+
+import std;
+
+import :report;
+
+namespace advent {
+
+    /*
+        The options a day's executable may be run with.
+
+        Each argument not recognized as an option is taken
+        to be the path to a puzzle input, where '-' refers to
+        our standard input. Given several inputs, or a directory
+        of them, we solve every one of them as a batch.
+    */
+    export struct run_options {
+        static constexpr std::string_view Usage = (
+            "<input | - | directory>..."
+            " [--bench <iterations>]"
+            " [--warmup <iterations>]"
+            " [--parallel]"
+            " [--threads <count>]"
+            " [--stream]"
+            " [--counters]"
+            " [--trace <path>]"
+            " [--format human|json|csv]"
+            " [--variants]"
+            " [--budget <milliseconds>]"
+            " [--pin <cpu>]"
+            " [--high-priority]"
+            " [--cache <directory>]"
+        );
+
+        /* The first of our 'input_paths'. */
+        const char *input_path = nullptr;
+
+        std::vector<const char *> input_paths;
+
+        /* How many threads solve a batch of inputs, or zero for as many as we have cores. */
+        std::size_t num_threads = 0;
+
+        /* When nonzero, each part is solved this many times and statistics are reported. */
+        std::size_t bench_iterations = 0;
+
+        static constexpr std::size_t DefaultWarmupIterations = 1;
+
+        /* Untimed iterations performed before benchmarking. */
+        std::size_t warmup_iterations = DefaultWarmupIterations;
+
+        /* Whether each part should be solved on its own thread. */
+        bool solve_parts_concurrently = false;
+
+        /* Whether to begin solving while the input is still being read, such as from a pipe. */
+        bool stream_input = false;
+
+        /* Whether to count hardware events, such as cycles and cache misses, while solving. */
+        bool count_events = false;
+
+        /* How long each part may take, over every iteration, before it's cancelled, or zero for forever. */
+        std::chrono::milliseconds part_budget = std::chrono::milliseconds::zero();
+
+        /* The CPU to pin our solving thread to, if any, so that it isn't migrated while being timed. */
+        std::optional<std::size_t> pinned_cpu;
+
+        /* Whether to raise our solving thread's priority as far as we're allowed. */
+        bool raise_priority = false;
+
+        /* Where to cache parsed inputs, for days which support it, if anywhere. */
+        const char *cache_directory = nullptr;
+
+        /* Whether to benchmark each part's variants against its reference solver. */
+        bool compare_variants = false;
+
+        advent::output_format format = advent::output_format::human;
+
+        /* Where to write a Chrome trace of every 'advent::trace_scope', if anywhere. */
+        const char *trace_path = nullptr;
+
+        /*
+            NOTE: These aren't parsed from the command line, but are
+            filled in by whoever runs the day, for use in our records.
+        */
+        advent::puzzle_id puzzle      = {};
+        std::size_t       input_bytes = 0;
+
+        constexpr bool is_benchmarking(this const run_options &self) {
+            return self.bench_iterations > 0;
+        }
+
+        constexpr bool has_budget(this const run_options &self) {
+            return self.part_budget > std::chrono::milliseconds::zero();
+        }
+
+        /* Whether we should ready ourselves for repeatable timings. */
+        constexpr bool wants_stable_timings(this const run_options &self) {
+            return self.is_benchmarking() || self.compare_variants || self.pinned_cpu.has_value() || self.raise_priority;
+        }
+
+        constexpr bool has_many_inputs(this const run_options &self) {
+            return self.input_paths.size() > 1;
+        }
+
+        /*
+            The options we were given which solving a batch of inputs
+            ignores, since each input is then solved just the once, and
+            on a pool of threads rather than on a thread of its own.
+        */
+        constexpr std::vector<std::string_view> options_ignored_in_batch(this const run_options &self) {
+            std::vector<std::string_view> ignored;
+
+            if (self.is_benchmarking()) {
+                ignored.push_back("--bench");
+            }
+
+            if (self.warmup_iterations != DefaultWarmupIterations) {
+                ignored.push_back("--warmup");
+            }
+
+            if (self.count_events) {
+                ignored.push_back("--counters");
+            }
+
+            if (self.solve_parts_concurrently) {
+                ignored.push_back("--parallel");
+            }
+
+            if (self.stream_input) {
+                ignored.push_back("--stream");
+            }
+
+            if (self.pinned_cpu.has_value()) {
+                ignored.push_back("--pin");
+            }
+
+            if (self.compare_variants) {
+                ignored.push_back("--variants");
+            }
+
+            /* NOTE: Each job only gets the default options, and so has no budget or cache. */
+            if (self.has_budget()) {
+                ignored.push_back("--budget");
+            }
+
+            if (self.cache_directory != nullptr) {
+                ignored.push_back("--cache");
+            }
+
+            if (self.raise_priority) {
+                ignored.push_back("--high-priority");
+            }
+
+            return ignored;
+        }
+    };
+
+    namespace impl {
+
+        constexpr auto parse_count(const std::string_view arg) -> std::optional<std::size_t> {
+            std::size_t count;
+
+            const auto [end, error] = std::from_chars(arg.data(), arg.data() + arg.size(), count);
+            if (error != std::errc() || end != arg.data() + arg.size()) {
+                return std::nullopt;
+            }
+
+            return count;
+        }
+
+    }
+
+    /* 'argv' is a pointer to a const pointer to a const 'char'. */
+    export constexpr auto parse_run_options(int argc, const char * const *argv) -> std::optional<advent::run_options> {
+        if (argc < 2) {
+            return std::nullopt;
+        }
+
+        const auto args = std::span(argv, static_cast<std::size_t>(argc));
+
+        advent::run_options options;
+
+        /* NOTE: We skip the program name. */
+        for (auto it = args.begin() + 1; it < args.end(); ++it) {
+            const auto arg = std::string_view(*it);
+
+            const auto next_count = [&]() -> std::optional<std::size_t> {
+                ++it;
+                if (it >= args.end()) {
+                    return std::nullopt;
+                }
+
+                return impl::parse_count(*it);
+            };
+
+            if (arg == "--bench") {
+                const auto count = next_count();
+                if (not count.has_value() || *count <= 0) {
+                    return std::nullopt;
+                }
+
+                options.bench_iterations = *count;
+            } else if (arg == "--warmup") {
+                const auto count = next_count();
+                if (not count.has_value()) {
+                    return std::nullopt;
+                }
+
+                options.warmup_iterations = *count;
+            } else if (arg == "--parallel") {
+                options.solve_parts_concurrently = true;
+            } else if (arg == "--stream") {
+                options.stream_input = true;
+            } else if (arg == "--counters") {
+                options.count_events = true;
+            } else if (arg == "--budget") {
+                const auto count = next_count();
+                if (not count.has_value() || *count <= 0) {
+                    return std::nullopt;
+                }
+
+                options.part_budget = std::chrono::milliseconds(*count);
+            } else if (arg == "--pin") {
+                const auto cpu = next_count();
+                if (not cpu.has_value()) {
+                    return std::nullopt;
+                }
+
+                options.pinned_cpu = *cpu;
+            } else if (arg == "--high-priority") {
+                options.raise_priority = true;
+            } else if (arg == "--cache") {
+                ++it;
+                if (it >= args.end()) {
+                    return std::nullopt;
+                }
+
+                options.cache_directory = *it;
+            } else if (arg == "--variants") {
+                options.compare_variants = true;
+            } else if (arg == "--trace") {
+                ++it;
+                if (it >= args.end()) {
+                    return std::nullopt;
+                }
+
+                options.trace_path = *it;
+            } else if (arg == "--format") {
+                ++it;
+                if (it >= args.end()) {
+                    return std::nullopt;
+                }
+
+                const auto format = advent::parse_output_format(*it);
+                if (not format.has_value()) {
+                    return std::nullopt;
+                }
+
+                options.format = *format;
+            } else if (arg == "--threads") {
+                const auto count = next_count();
+                if (not count.has_value() || *count <= 0) {
+                    return std::nullopt;
+                }
+
+                options.num_threads = *count;
+            } else {
+                options.input_paths.push_back(*it);
+            }
+        }
+
+        if (options.input_paths.empty()) {
+            return std::nullopt;
+        }
+
+        /*
+            NOTE: Our parts' threads would all share the one CPU we're
+            pinned to, which defeats the point of either option.
+        */
+        if (options.pinned_cpu.has_value() && options.solve_parts_concurrently) {
+            return std::nullopt;
+        }
+
+        /*
+            NOTE: We can only tell whether a single input is a directory
+            of inputs once we try to solve it, and so that case merely
+            warns about these instead.
+        */
+        if (options.has_many_inputs() && not options.options_ignored_in_batch().empty()) {
+            return std::nullopt;
+        }
+
+        options.input_path = options.input_paths.front();
+
+        return options;
+    }
+
+}
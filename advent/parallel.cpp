@@ -0,0 +1,284 @@
+export module advent:parallel;
+
+import std;
+
+import :concepts;
+import :split_string_view;
+import :thread_pool;
+
+namespace advent {
+
+    namespace impl {
+
+        /* Below this, splitting the work up costs more than it saves. */
+        constexpr inline std::size_t MinParallelChunkSize = 1uz << 14;
+
+        /*
+            Splits 'data' into about 'num_chunks' pieces at newlines,
+            dropping the newline between each piece, so that splitting
+            each piece into lines gives exactly the lines of 'data'.
+        */
+        constexpr std::vector<std::string_view> partition_at_newlines(const std::string_view data, const std::size_t num_chunks) {
+            std::vector<std::string_view> chunks;
+
+            std::size_t pos = 0;
+            for (const auto i : std::views::iota(1uz, std::max(num_chunks, 1uz))) {
+                const auto target = std::max(pos, data.size() * i / num_chunks);
+
+                const auto newline_pos = data.find('\n', target);
+                if (newline_pos == std::string_view::npos) {
+                    break;
+                }
+
+                chunks.push_back(data.substr(pos, newline_pos - pos));
+
+                pos = newline_pos + 1;
+            }
+
+            chunks.push_back(data.substr(pos));
+
+            return chunks;
+        }
+
+        static_assert(impl::partition_at_newlines("ab\ncd\nef", 1) == std::vector<std::string_view>{"ab\ncd\nef"});
+        static_assert(impl::partition_at_newlines("ab\ncd\nef", 2) == std::vector<std::string_view>{"ab\ncd", "ef"});
+        static_assert(impl::partition_at_newlines("ab\ncd\nef", 8) == std::vector<std::string_view>{"ab", "cd", "ef"});
+        static_assert(impl::partition_at_newlines("ab\n", 2) == std::vector<std::string_view>{"ab", ""});
+
+        /*
+            Folds 'rng' with 'reduce' over what 'map' gives for each element.
+
+            NOTE: An empty 'rng' gives a value-initialized result, e.g. zero
+            for a sum, which is also what most solvers would give for no input.
+        */
+        template<std::ranges::input_range R, typename Map, typename Reduce>
+        constexpr auto map_reduce(R &&rng, const Map &map, const Reduce &reduce) {
+            using Result = std::remove_cvref_t<std::invoke_result_t<const Map &, std::ranges::range_reference_t<R>>>;
+
+            auto it = std::ranges::begin(rng);
+            if (it == std::ranges::end(rng)) {
+                return Result{};
+            }
+
+            Result result = std::invoke(map, *it);
+            for (++it; it != std::ranges::end(rng); ++it) {
+                result = std::invoke(reduce, std::move(result), std::invoke(map, *it));
+            }
+
+            return result;
+        }
+
+        /*
+            Runs 'reduce_chunk' on each of 'num_chunks' chunks on a thread
+            pool, the calling thread included, and combines their results
+            in order so that 'reduce' needn't be commutative.
+
+            Chunks are claimed from a shared counter rather than taken from
+            the pool's queues, so that while we wait we only ever help with
+            our own chunks, and never with whatever else the pool is running,
+            such as the other jobs of a batch, which would then be timed as
+            though it were part of our own work.
+        */
+        template<typename ReduceChunk, typename Reduce>
+        auto reduce_chunks_in_parallel(advent::thread_pool &pool, const std::size_t num_chunks, const ReduceChunk &reduce_chunk, const Reduce &reduce) {
+            using Result = std::remove_cvref_t<std::invoke_result_t<const ReduceChunk &, std::size_t>>;
+
+            [[assume(num_chunks > 0)]];
+
+            struct progress {
+                std::atomic<std::size_t> next_chunk    = 0;
+                std::atomic<std::size_t> num_remaining = 0;
+            };
+
+            std::vector<std::optional<Result>> results(num_chunks);
+
+            /*
+                NOTE: A task may only start once we've claimed every chunk
+                and returned, and so it shares ownership of our progress,
+                and only touches anything else once it's claimed a chunk.
+            */
+            const auto shared_progress = std::make_shared<progress>();
+            shared_progress->num_remaining.store(num_chunks, std::memory_order_relaxed);
+
+            const auto reduce_claimed_chunks = [&results, &reduce_chunk, num_chunks](progress &state) {
+                while (true) {
+                    const auto i = state.next_chunk.fetch_add(1, std::memory_order_relaxed);
+                    if (i >= num_chunks) {
+                        return;
+                    }
+
+                    results[i].emplace(std::invoke(reduce_chunk, i));
+
+                    if (state.num_remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                        state.num_remaining.notify_all();
+                    }
+                }
+            };
+
+            for (auto _ : std::views::iota(1uz, num_chunks)) {
+                pool.submit([shared_progress, reduce_claimed_chunks]() {
+                    reduce_claimed_chunks(*shared_progress);
+                });
+            }
+
+            reduce_claimed_chunks(*shared_progress);
+
+            /* Whatever's left was claimed by tasks which are still running. */
+            for (
+                auto remaining = shared_progress->num_remaining.load(std::memory_order_acquire);
+                remaining > 0;
+                remaining = shared_progress->num_remaining.load(std::memory_order_acquire)
+            ) {
+                shared_progress->num_remaining.wait(remaining, std::memory_order_acquire);
+            }
+
+            return impl::map_reduce(results, [](auto &result) -> Result {
+                return std::move(*result);
+            }, reduce);
+        }
+
+        /* Solvers running inside a pool, such as when solving a batch of inputs, share that pool. */
+        inline auto parallel_pool() -> advent::thread_pool & {
+            if (const auto current = advent::thread_pool::current(); current != nullptr) {
+                return *current;
+            }
+
+            return advent::thread_pool::shared();
+        }
+
+    }
+
+    /*
+        Maps each line of 'data' and folds the results together
+        with 'reduce', splitting the lines into a chunk for each
+        worker of a thread pool, and folding each chunk in parallel.
+
+        Lines are split exactly as 'advent::views::split_lines' would,
+        so 'map' is also given the empty line after a trailing newline.
+
+        NOTE: 'map' and 'reduce' are called from several threads at once,
+        and so are only ever called through const references. 'reduce'
+        must be associative, but needn't be commutative.
+
+        NOTE: '--counters' only counts events on the thread being measured,
+        and so misses whatever work is handed off to the other workers.
+
+        During constant evaluation, this is a plain sequential loop.
+    */
+    export template<typename Map, typename Reduce>
+    requires (
+        std::invocable<const Map &, std::string_view> &&
+
+        std::invocable<
+            const Reduce &,
+
+            std::remove_cvref_t<std::invoke_result_t<const Map &, std::string_view>>,
+            std::remove_cvref_t<std::invoke_result_t<const Map &, std::string_view>>
+        >
+    )
+    constexpr auto parallel_line_reduce(std::string_view data, const Map map, const Reduce reduce) {
+        /* NOTE: Even no data at all has a single, empty, line. */
+        if (data.data() == nullptr) {
+            data = "";
+        }
+
+        if consteval {
+            return impl::map_reduce(data | advent::views::split_lines, map, reduce);
+        } else {
+            auto &pool = impl::parallel_pool();
+
+            const auto num_chunks = std::min(pool.num_workers(), std::max(data.size() / impl::MinParallelChunkSize, 1uz));
+
+            const auto chunks = impl::partition_at_newlines(data, num_chunks);
+            if (chunks.size() <= 1) {
+                return impl::map_reduce(data | advent::views::split_lines, map, reduce);
+            }
+
+            return impl::reduce_chunks_in_parallel(pool, chunks.size(), [&](const std::size_t i) {
+                return impl::map_reduce(chunks[i] | advent::views::split_lines, map, reduce);
+            }, reduce);
+        }
+    }
+
+    /*
+        The same as above, but for lines which were already split up.
+
+        Lines split from a whole string at newlines are folded in
+        parallel over that string. Any other lines, such as those
+        streamed in as they're read, are folded in order on the
+        calling thread, as we can't hand them out up front.
+    */
+    export template<advent::string_viewable_range Rng, typename Map, typename Reduce>
+    requires (
+        std::invocable<const Map &, std::string_view> &&
+
+        std::invocable<
+            const Reduce &,
+
+            std::remove_cvref_t<std::invoke_result_t<const Map &, std::string_view>>,
+            std::remove_cvref_t<std::invoke_result_t<const Map &, std::string_view>>
+        >
+    )
+    constexpr auto parallel_line_reduce(Rng &&lines, const Map map, const Reduce reduce) {
+        if constexpr (std::same_as<std::remove_cvref_t<Rng>, advent::split_string_view>) {
+            if (lines._delimiter == '\n' && lines._str.data() != nullptr) {
+                return advent::parallel_line_reduce(lines._str, map, reduce);
+            }
+        }
+
+        return impl::map_reduce(std::forward<Rng>(lines), [&](const std::string_view line) {
+            return std::invoke(map, line);
+        }, reduce);
+    }
+
+    /*
+        The same as 'advent::parallel_line_reduce', but over the
+        elements of a range, for solvers which parse their input first.
+
+        NOTE: As with 'impl::map_reduce', an empty 'rng'
+        gives a value-initialized result, such as zero.
+    */
+    export template<std::ranges::random_access_range R, typename Map, typename Reduce>
+    requires (
+        std::ranges::sized_range<R>                                  &&
+        std::invocable<const Map &, std::ranges::range_reference_t<R>> &&
+
+        std::invocable<
+            const Reduce &,
+
+            std::remove_cvref_t<std::invoke_result_t<const Map &, std::ranges::range_reference_t<R>>>,
+            std::remove_cvref_t<std::invoke_result_t<const Map &, std::ranges::range_reference_t<R>>>
+        >
+    )
+    constexpr auto parallel_reduce(R &&rng, const Map map, const Reduce reduce) {
+        if consteval {
+            return impl::map_reduce(rng, map, reduce);
+        } else {
+            auto &pool = impl::parallel_pool();
+
+            const auto size       = static_cast<std::size_t>(std::ranges::size(rng));
+            const auto num_chunks = std::min(pool.num_workers(), size);
+
+            if (num_chunks <= 1) {
+                return impl::map_reduce(rng, map, reduce);
+            }
+
+            return impl::reduce_chunks_in_parallel(pool, num_chunks, [&](const std::size_t i) {
+                const auto start = size * i       / num_chunks;
+                const auto end   = size * (i + 1) / num_chunks;
+
+                return impl::map_reduce(std::ranges::subrange(
+                    std::ranges::begin(rng) + static_cast<std::ranges::range_difference_t<R>>(start),
+                    std::ranges::begin(rng) + static_cast<std::ranges::range_difference_t<R>>(end)
+                ), map, reduce);
+            }, reduce);
+        }
+    }
+
+    static_assert(advent::parallel_line_reduce("1\n22\n333", [](const std::string_view line) { return line.size(); }, std::plus{}) == 6);
+    static_assert(advent::parallel_line_reduce("1\n22\n333" | advent::views::split_lines, [](const std::string_view line) { return line.size(); }, std::plus{}) == 6);
+    static_assert(advent::parallel_line_reduce(std::array<std::string_view, 3>{"1", "22", "333"}, [](const std::string_view line) { return line.size(); }, std::plus{}) == 6);
+    static_assert(advent::parallel_reduce(std::array{1, 2, 3}, std::identity{}, std::plus{}) == 6);
+    static_assert(advent::parallel_reduce(std::vector<int>{}, std::identity{}, std::plus{}) == 0);
+
+}
@@ -0,0 +1,279 @@
+module;
+
+/* NOTE: Needed for 'getpid'. */
+#include <unistd.h>
+
+export module advent:parse_cache;
+
+import std;
+
+import :mapped_file;
+import :report;
+
+namespace advent {
+
+    /*
+        Serializes a parsed model into the bytes of a cache file.
+
+        Spans are aligned within the file for their elements, and since
+        the file is mapped at a page boundary, the reader may view them
+        as arrays without first copying them into aligned memory.
+    */
+    export struct cache_writer {
+        std::string _bytes;
+
+        auto _align_to(this cache_writer &self, const std::size_t alignment) -> void {
+            self._bytes.resize((self._bytes.size() + alignment - 1) / alignment * alignment, '\0');
+        }
+
+        template<typename T>
+        requires (std::is_trivially_copyable_v<T>)
+        auto write(this cache_writer &self, const T &value) -> void {
+            self._align_to(alignof(T));
+
+            self._bytes.append(reinterpret_cast<const char *>(std::addressof(value)), sizeof(T));
+        }
+
+        template<typename T>
+        requires (std::is_trivially_copyable_v<T>)
+        auto write_span(this cache_writer &self, const std::span<const T> values) -> void {
+            self.write(static_cast<std::uint64_t>(values.size()));
+
+            self._align_to(alignof(T));
+
+            self._bytes.append(reinterpret_cast<const char *>(values.data()), values.size_bytes());
+        }
+
+        auto bytes(this const cache_writer &self) -> std::string_view {
+            return self._bytes;
+        }
+    };
+
+    /*
+        Reads a parsed model back out of a mapped cache file.
+
+        Anything read past the end of the cache leaves the reader failed,
+        and gives back empty values, so that a model needn't check after
+        every read, and the cache is simply ignored if anything failed.
+
+        NOTE: Spans point into the mapped file, which is unmapped
+        once the model is read, so the model must copy what it keeps.
+    */
+    export struct cache_reader {
+        std::string_view _bytes;
+        std::size_t      _pos = 0;
+
+        bool _failed = false;
+
+        auto _take(this cache_reader &self, const std::size_t alignment, const std::size_t size) -> const char * {
+            const auto start = (self._pos + alignment - 1) / alignment * alignment;
+
+            if (self._failed || start > self._bytes.size() || size > self._bytes.size() - start) {
+                self._failed = true;
+
+                return nullptr;
+            }
+
+            self._pos = start + size;
+
+            return self._bytes.data() + start;
+        }
+
+        template<typename T>
+        requires (std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T>)
+        auto read(this cache_reader &self) -> T {
+            const auto data = self._take(alignof(T), sizeof(T));
+            if (data == nullptr) {
+                return T{};
+            }
+
+            T value;
+            std::memcpy(std::addressof(value), data, sizeof(T));
+
+            return value;
+        }
+
+        template<typename T>
+        requires (std::is_trivially_copyable_v<T>)
+        auto read_span(this cache_reader &self) -> std::span<const T> {
+            const auto size = self.read<std::uint64_t>();
+            if (size > self._bytes.size() / std::max(sizeof(T), 1uz)) {
+                self._failed = true;
+
+                return {};
+            }
+
+            const auto data = self._take(alignof(T), static_cast<std::size_t>(size) * sizeof(T));
+            if (data == nullptr) {
+                return {};
+            }
+
+            /* NOTE: Our mapping is page-aligned and the writer aligned this span, so it's a valid array. */
+            return std::span(std::launder(reinterpret_cast<const T *>(data)), static_cast<std::size_t>(size));
+        }
+
+        /* For models to reject what they read, such as sizes which don't agree with each other. */
+        auto fail(this cache_reader &self) -> void {
+            self._failed = true;
+        }
+
+        /* Whether everything was read, and nothing more than that. */
+        auto succeeded(this const cache_reader &self) -> bool {
+            return not self._failed && self._pos == self._bytes.size();
+        }
+    };
+
+    /*
+        A parsed model which may be cached, keyed by the input it was
+        parsed from, so that later runs may skip parsing it entirely.
+
+        'CacheVersion' must be bumped whenever the model's layout
+        or its serialization changes, so that stale caches are ignored.
+    */
+    export template<typename T>
+    concept cacheable = requires(const T &model, advent::cache_writer &writer, advent::cache_reader &reader) {
+        { T::CacheVersion } -> std::convertible_to<std::uint32_t>;
+
+        model.serialize(writer);
+
+        { T::Deserialize(reader) } -> std::same_as<T>;
+    };
+
+    /* 64-bit FNV-1a, which is plenty to tell our inputs apart. */
+    export constexpr auto hash_input(const std::string_view input) -> std::uint64_t {
+        static constexpr std::uint64_t OffsetBasis = 0xCBF29CE484222325;
+        static constexpr std::uint64_t Prime       = 0x100000001B3;
+
+        auto hash = OffsetBasis;
+        for (const auto c : input) {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= Prime;
+        }
+
+        return hash;
+    }
+
+    static_assert(advent::hash_input("") == 0xCBF29CE484222325);
+    static_assert(advent::hash_input("a") == 0xAF63DC4C8601EC8C);
+
+    namespace impl {
+
+        struct cache_header {
+            static constexpr std::array<char, 8> Magic = {'A', 'D', 'V', 'C', 'A', 'C', 'H', 'E'};
+
+            /* Bumped whenever this header or the writer's layout changes. */
+            static constexpr std::uint32_t FormatVersion = 1;
+
+            std::array<char, 8> magic          = Magic;
+            std::uint32_t       format_version = FormatVersion;
+            std::uint32_t       model_version  = 0;
+            std::uint64_t       input_hash     = 0;
+            std::uint64_t       input_size     = 0;
+            std::uint64_t       payload_size   = 0;
+
+            /* NOTE: Pads us out so that the payload after us is suitably aligned. */
+            std::uint64_t _reserved = 0;
+        };
+
+        /* NOTE: This keeps every payload aligned for anything we may write. */
+        static_assert(sizeof(cache_header) % alignof(std::max_align_t) == 0);
+
+    }
+
+    /* Where the cached model for 'puzzle', parsed from 'input', lives within 'directory'. */
+    export auto parse_cache_path(const std::filesystem::path &directory, const advent::puzzle_id puzzle, const std::string_view input) -> std::filesystem::path {
+        return directory / std::format("{}_Day_{:02}_{:016x}.cache", puzzle.year, puzzle.day, advent::hash_input(input));
+    }
+
+    /* Maps the model cached at 'path' back in, if it was cached from this same 'input' and version. */
+    export template<advent::cacheable T>
+    auto load_cached(const std::filesystem::path &path, const std::string_view input) -> std::optional<T> {
+        const auto mapped = advent::mapped_file::map(path.c_str());
+        if (not mapped.has_value() || mapped->size() < sizeof(impl::cache_header)) {
+            return std::nullopt;
+        }
+
+        impl::cache_header header;
+        std::memcpy(&header, mapped->data(), sizeof(header));
+
+        const auto matches = (
+            header.magic          == impl::cache_header::Magic         &&
+            header.format_version == impl::cache_header::FormatVersion &&
+            header.model_version  == T::CacheVersion                   &&
+            header.input_size     == input.size()                      &&
+            header.input_hash     == advent::hash_input(input)         &&
+            header.payload_size   == mapped->size() - sizeof(header)
+        );
+
+        if (not matches) {
+            return std::nullopt;
+        }
+
+        auto reader = advent::cache_reader{
+            ._bytes = mapped->view().substr(sizeof(header)),
+        };
+
+        auto model = T::Deserialize(reader);
+        if (not reader.succeeded()) {
+            return std::nullopt;
+        }
+
+        return model;
+    }
+
+    /*
+        Caches 'model', parsed from 'input', at 'path'.
+
+        NOTE: We write to a temporary file and then rename it into place,
+        so that a cache which is being written is never read half-written.
+        Each write gets its own temporary file, so that several processes,
+        or threads solving a batch, may cache the same input at once.
+    */
+    export template<advent::cacheable T>
+    auto store_cached(const std::filesystem::path &path, const std::string_view input, const T &model) -> bool {
+        advent::cache_writer writer;
+        model.serialize(writer);
+
+        const auto header = impl::cache_header{
+            .model_version = T::CacheVersion,
+            .input_hash    = advent::hash_input(input),
+            .input_size    = input.size(),
+            .payload_size  = writer.bytes().size(),
+        };
+
+        std::error_code error;
+        std::filesystem::create_directories(path.parent_path(), error);
+
+        static constinit std::atomic<std::uint64_t> num_temporaries = 0;
+
+        auto temporary_path = path;
+        temporary_path += std::format(".{}.{}.tmp", ::getpid(), num_temporaries.fetch_add(1, std::memory_order_relaxed));
+
+        {
+            auto file = std::ofstream(temporary_path, std::ios::binary | std::ios::trunc);
+
+            file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+            file.write(writer.bytes().data(), static_cast<std::streamsize>(writer.bytes().size()));
+
+            if (not file) {
+                file.close();
+
+                std::filesystem::remove(temporary_path, error);
+
+                return false;
+            }
+        }
+
+        std::filesystem::rename(temporary_path, path, error);
+        if (error) {
+            /* NOTE: We've already failed, so we ignore whether this fails too. */
+            std::error_code remove_error;
+            std::filesystem::remove(temporary_path, remove_error);
+
+            return false;
+        }
+
+        return true;
+    }
+
+}
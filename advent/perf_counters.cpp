@@ -0,0 +1,343 @@
+module;
+
+/* NOTE: Needed for 'perf_event_open' and friends. */
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+export module advent:perf_counters;
+
+import std;
+
+namespace advent {
+
+    /* The hardware and software events we count around a measured scope. */
+    export enum class perf_event : std::size_t {
+        cycles,
+        instructions,
+        branch_misses,
+        l1d_misses,
+        llc_misses,
+        page_faults,
+
+        _count,
+    };
+
+    /*
+        The values counted over a measured scope.
+
+        Any event which could not be counted, such as when
+        the hardware doesn't support it, holds 'std::nullopt'.
+    */
+    export struct perf_counts {
+        std::array<std::optional<std::uint64_t>, std::to_underlying(advent::perf_event::_count)> _values = {};
+
+        constexpr std::optional<std::uint64_t> operator [](this const perf_counts &self, const advent::perf_event event) {
+            return self._values[std::to_underlying(event)];
+        }
+
+        constexpr bool has_any(this const perf_counts &self) {
+            return std::ranges::any_of(self._values, [](const auto &value) {
+                return value.has_value();
+            });
+        }
+
+        constexpr std::optional<std::float64_t> instructions_per_cycle(this const perf_counts &self) {
+            const auto cycles       = self[advent::perf_event::cycles];
+            const auto instructions = self[advent::perf_event::instructions];
+
+            if (not cycles.has_value() || not instructions.has_value() || *cycles <= 0) {
+                return std::nullopt;
+            }
+
+            return static_cast<std::float64_t>(*instructions) / static_cast<std::float64_t>(*cycles);
+        }
+
+        /* How many of 'event' happened for every thousand instructions. */
+        constexpr std::optional<std::float64_t> per_kilo_instruction(this const perf_counts &self, const advent::perf_event event) {
+            const auto count        = self[event];
+            const auto instructions = self[advent::perf_event::instructions];
+
+            if (not count.has_value() || not instructions.has_value() || *instructions <= 0) {
+                return std::nullopt;
+            }
+
+            return 1000 * static_cast<std::float64_t>(*count) / static_cast<std::float64_t>(*instructions);
+        }
+
+        /* Divides each count, such as to average them over several iterations. */
+        constexpr perf_counts operator /(this const perf_counts &self, const std::uint64_t divisor) {
+            auto divided = self;
+
+            for (auto &value : divided._values) {
+                if (value.has_value()) {
+                    *value /= divisor;
+                }
+            }
+
+            return divided;
+        }
+    };
+
+    /*
+        Counts events for the calling thread with Linux's 'perf_event_open'.
+
+        Perf is often unavailable, such as in containers or when
+        'perf_event_paranoid' forbids it, in which case we count
+        nothing and every measurement is simply 'std::nullopt'.
+
+        Every event is opened into a single group, so that they're
+        all counted over the same time, and ratios between them, such
+        as instructions per cycle, compare like with like. Events which
+        wouldn't fit into the group alongside the others are left out.
+
+        NOTE: Work handed off to other threads, such as by
+        'advent::parallel_line_reduce', isn't counted at all.
+    */
+    export struct perf_counters {
+        static constexpr auto NumEvents = std::to_underlying(advent::perf_event::_count);
+
+        std::array<int, NumEvents> _fds;
+
+        perf_counts _counts;
+
+        constexpr perf_counters() {
+            this->_fds.fill(-1);
+        }
+
+        perf_counters(const perf_counters &) = delete;
+        perf_counters &operator =(const perf_counters &) = delete;
+
+        constexpr perf_counters(perf_counters &&other) : _fds(other._fds), _counts(other._counts) {
+            other._fds.fill(-1);
+        }
+
+        perf_counters &operator =(perf_counters &&) = delete;
+
+        constexpr ~perf_counters() {
+            if !consteval {
+                for (const auto fd : this->_fds) {
+                    if (fd >= 0) {
+                        ::close(fd);
+                    }
+                }
+            }
+        }
+
+        static auto _event_attributes(const advent::perf_event event) -> perf_event_attr {
+            static constexpr auto cache_miss = [](const std::uint64_t cache) -> std::uint64_t {
+                return (
+                    cache |
+                    (PERF_COUNT_HW_CACHE_OP_READ     << 8) |
+                    (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)
+                );
+            };
+
+            const auto [type, config] = [&]() -> std::pair<std::uint32_t, std::uint64_t> {
+                switch (event) {
+                    case advent::perf_event::cycles:        return {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES};
+                    case advent::perf_event::instructions:  return {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS};
+                    case advent::perf_event::branch_misses: return {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES};
+                    case advent::perf_event::l1d_misses:    return {PERF_TYPE_HW_CACHE, cache_miss(PERF_COUNT_HW_CACHE_L1D)};
+                    case advent::perf_event::llc_misses:    return {PERF_TYPE_HW_CACHE, cache_miss(PERF_COUNT_HW_CACHE_LL)};
+                    case advent::perf_event::page_faults:   return {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS};
+
+                    default: std::unreachable();
+                }
+            }();
+
+            perf_event_attr attributes = {};
+
+            attributes.size   = sizeof(attributes);
+            attributes.type   = type;
+            attributes.config = config;
+
+            /*
+                We only start counting once we begin measuring.
+
+                NOTE: This only matters for the group's leader,
+                which every other event is enabled alongside.
+            */
+            attributes.disabled = 1;
+
+            /*
+                NOTE: Only counting our own code is both what we
+                want and what a cautious 'perf_event_paranoid' allows,
+                and that goes for software events such as page faults too.
+            */
+            attributes.exclude_kernel = 1;
+            attributes.exclude_hv     = 1;
+
+            /* So that we read every event at once, and can scale counts which were multiplexed with other groups. */
+            attributes.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+            return attributes;
+        }
+
+        /* What's read from the group's leader, as laid out by our 'read_format'. */
+        struct _reading {
+            std::uint64_t num_events;
+            std::uint64_t time_enabled;
+            std::uint64_t time_running;
+
+            /* NOTE: In the order each event joined the group, the leader first. */
+            std::array<std::uint64_t, NumEvents> values;
+        };
+
+        /* The event leading our group, which every other event is read and controlled through. */
+        constexpr int _leader(this const perf_counters &self) {
+            const auto it = std::ranges::find_if(self._fds, [](const int fd) {
+                return fd >= 0;
+            });
+
+            if (it == self._fds.end()) {
+                return -1;
+            }
+
+            return *it;
+        }
+
+        /* Where 'index' is within our group, since events which failed to open never joined it. */
+        constexpr std::size_t _group_position(this const perf_counters &self, const std::size_t index) {
+            return static_cast<std::size_t>(std::ranges::count_if(self._fds | std::views::take(index), [](const int fd) {
+                return fd >= 0;
+            }));
+        }
+
+        static auto _read(const int leader, const std::size_t num_opened) -> std::optional<_reading> {
+            _reading reading;
+
+            const auto num_read   = ::read(leader, &reading, sizeof(reading));
+            const auto num_needed = sizeof(reading) - sizeof(reading.values) + num_opened * sizeof(std::uint64_t);
+
+            if (num_read < 0 || static_cast<std::size_t>(num_read) < num_needed || reading.num_events != num_opened) {
+                return std::nullopt;
+            }
+
+            return reading;
+        }
+
+        /*
+            When other groups also want the hardware counters, such as
+            those of a profiler, the kernel takes turns counting each
+            group, so we scale up each count by how much of the time our
+            group was actually being counted.
+
+            NOTE: The times only ever grow, unlike the counts, which we reset,
+            so we take the times since 'start', which was read at the reset.
+        */
+        static auto _scaled_count(const _reading &start, const _reading &end, const std::uint64_t value) -> std::optional<std::uint64_t> {
+            const auto time_enabled = end.time_enabled - start.time_enabled;
+            const auto time_running = end.time_running - start.time_running;
+
+            /* The event was never scheduled at all, so we know nothing of it. */
+            if (time_running <= 0) {
+                return std::nullopt;
+            }
+
+            if (time_running >= time_enabled) {
+                return value;
+            }
+
+            return static_cast<std::uint64_t>(
+                static_cast<std::float64_t>(value) * static_cast<std::float64_t>(time_enabled) / static_cast<std::float64_t>(time_running)
+            );
+        }
+
+        /* Opens whichever counters we're allowed to for the calling thread. */
+        static auto open() -> perf_counters {
+            perf_counters counters;
+
+            for (const auto index : std::views::iota(0uz, NumEvents)) {
+                auto attributes = perf_counters::_event_attributes(static_cast<advent::perf_event>(index));
+
+                /*
+                    NOTE: A pid of 0 and a cpu of -1 counts the calling thread on any CPU.
+
+                    The first event we manage to open leads the group, and the kernel
+                    refuses to add any event which would leave the group unschedulable.
+                */
+                counters._fds[index] = static_cast<int>(::syscall(SYS_perf_event_open, &attributes, 0, -1, counters._leader(), PERF_FLAG_FD_CLOEXEC));
+            }
+
+            return counters;
+        }
+
+        constexpr bool is_available(this const perf_counters &self) {
+            return std::ranges::any_of(self._fds, [](const int fd) {
+                return fd >= 0;
+            });
+        }
+
+        constexpr const perf_counts &last_measured_counts(this const perf_counters &self) {
+            return self._counts;
+        }
+
+        [[nodiscard]]
+        constexpr auto measure_scope(this perf_counters &self) {
+            struct scope_measurer {
+                scope_measurer(const scope_measurer &) = delete;
+                scope_measurer &operator =(const scope_measurer &) = delete;
+
+                scope_measurer(scope_measurer &&) = delete;
+                scope_measurer &operator =(scope_measurer &&) = delete;
+
+                perf_counters &_counters;
+
+                std::optional<_reading> _start_reading;
+
+                constexpr explicit scope_measurer(perf_counters &counters) : _counters(counters) {
+                    if !consteval {
+                        const auto leader = this->_counters._leader();
+                        if (leader >= 0) {
+                            ::ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+
+                            this->_start_reading = perf_counters::_read(leader, this->_counters._group_position(NumEvents));
+
+                            ::ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+                        }
+                    }
+                }
+
+                constexpr ~scope_measurer() {
+                    /* NOTE: Anything we fail to read is simply left as 'std::nullopt'. */
+                    this->_counters._counts = perf_counts{};
+
+                    if !consteval {
+                        const auto leader = this->_counters._leader();
+                        if (leader < 0) {
+                            return;
+                        }
+
+                        ::ioctl(leader, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+                        if (not this->_start_reading.has_value()) {
+                            return;
+                        }
+
+                        const auto end = perf_counters::_read(leader, this->_counters._group_position(NumEvents));
+                        if (not end.has_value()) {
+                            return;
+                        }
+
+                        for (const auto index : std::views::iota(0uz, NumEvents)) {
+                            if (this->_counters._fds[index] < 0) {
+                                continue;
+                            }
+
+                            this->_counters._counts._values[index] = perf_counters::_scaled_count(
+                                *this->_start_reading, *end,
+
+                                end->values[this->_counters._group_position(index)]
+                            );
+                        }
+                    }
+                }
+            };
+
+            return scope_measurer(self);
+        }
+    };
+
+}
@@ -1,33 +1,125 @@
+module;
+
+/* NOTE: Needed for 'errno' and 'write'. */
+#include <cerrno>
+#include <unistd.h>
+
 export module advent:print;
 
 import std;
 
 namespace advent {
 
+    namespace impl {
+
+        /*
+            Collects everything we print, so that it may be written
+            all at once rather than with many small writes, such as
+            when printing thousands of answers from a batch of inputs.
+
+            NOTE: Printing may happen from several threads, such as
+            from a watchdog while a part is still being solved.
+        */
+        struct output_buffer {
+            /* We write early should this much pile up, so that we never buffer without bound. */
+            static constexpr std::size_t FlushThreshold = 1uz << 20;
+
+            std::mutex  _mutex;
+            std::string _buffer;
+
+            output_buffer() = default;
+
+            output_buffer(const output_buffer &) = delete;
+            output_buffer &operator =(const output_buffer &) = delete;
+
+            /* Whatever's left is written as we exit. */
+            ~output_buffer() {
+                this->flush();
+            }
+
+            template<typename... Args>
+            auto append(this output_buffer &self, const bool newline, std::format_string<Args...> fmt, Args &&... args) -> void {
+                const auto _ = std::scoped_lock(self._mutex);
+
+                std::format_to(std::back_inserter(self._buffer), std::move(fmt), std::forward<Args>(args)...);
+
+                if (newline) {
+                    self._buffer.push_back('\n');
+                }
+
+                if (self._buffer.size() >= FlushThreshold) {
+                    self._write_all();
+                }
+            }
+
+            auto flush(this output_buffer &self) -> void {
+                const auto _ = std::scoped_lock(self._mutex);
+
+                self._write_all();
+            }
+
+            auto _write_all(this output_buffer &self) -> void {
+                auto remaining = std::string_view(self._buffer);
+
+                while (not remaining.empty()) {
+                    const auto num_written = ::write(STDOUT_FILENO, remaining.data(), remaining.size());
+                    if (num_written < 0) {
+                        if (errno == EINTR) {
+                            continue;
+                        }
+
+                        /* There's nowhere left to report this, so we drop what we couldn't write. */
+                        break;
+                    }
+
+                    remaining.remove_prefix(static_cast<std::size_t>(num_written));
+                }
+
+                self._buffer.clear();
+            }
+        };
+
+        inline auto global_output_buffer() -> impl::output_buffer & {
+            static impl::output_buffer buffer;
+
+            return buffer;
+        }
+
+    }
+
     /*
         These functions only print outside of constant evaluation.
 
         Mostly useful for debugging.
+
+        NOTE: What's printed is buffered until 'advent::flush_output'
+        is called, which we do after each part, or until we exit.
     */
 
     export template<typename... Args>
     constexpr void print(std::format_string<Args...> fmt, Args &&... args) {
         if !consteval {
-            std::print(std::move(fmt), std::forward<Args>(args)...);
+            impl::global_output_buffer().append(false, std::move(fmt), std::forward<Args>(args)...);
         }
     }
 
     export template<typename... Args>
     constexpr void println(std::format_string<Args...> fmt, Args &&... args) {
         if !consteval {
-            std::println(std::move(fmt), std::forward<Args>(args)...);
+            impl::global_output_buffer().append(true, std::move(fmt), std::forward<Args>(args)...);
         }
     }
 
     export constexpr void println() {
         if !consteval {
-            /* TODO: Just call the proper overload when we receive an implementation of it. */
-            std::print("\n");
+            impl::global_output_buffer().append(false, "\n");
+        }
+    }
+
+    /* Writes everything printed so far with a single write. */
+    export constexpr void flush_output() {
+        if !consteval {
+            impl::global_output_buffer().flush();
         }
     }
 
@@ -0,0 +1,55 @@
+module;
+
+/* NOTE: Needed for 'popen' and friends. */
+#include <stdio.h>
+
+export module advent:process;
+
+import std;
+
+namespace advent {
+
+    /* Runs 'command' through the shell, returning its output, or 'std::nullopt' if it failed. */
+    export auto run_command(const std::string &command) -> std::optional<std::string> {
+        const auto pipe = ::popen(command.c_str(), "r");
+        if (pipe == nullptr) {
+            return std::nullopt;
+        }
+
+        std::string output;
+
+        std::array<char, 4096> buffer;
+        while (true) {
+            const auto num_read = std::fread(buffer.data(), 1, buffer.size(), pipe);
+            if (num_read <= 0) {
+                break;
+            }
+
+            output.append(buffer.data(), num_read);
+        }
+
+        if (::pclose(pipe) != 0) {
+            return std::nullopt;
+        }
+
+        return output;
+    }
+
+    /* Wraps 'arg' in single quotes for the shell. */
+    export auto shell_quoted(const std::string_view arg) -> std::string {
+        std::string result = "'";
+
+        for (const auto c : arg) {
+            if (c == '\'') {
+                result += R"('\'')";
+            } else {
+                result += c;
+            }
+        }
+
+        result += '\'';
+
+        return result;
+    }
+
+}
@@ -1,16 +1,32 @@
 module;
 
-/* NOTE: Needed for 'SEEK_SET' and such. */
-#include <cstdio>
+/* NOTE: Needed for 'close'. */
+#include <unistd.h>
 
 export module advent:puzzle_data;
 
 import std;
 
 import :scope_guard;
+import :mapped_file;
+import :parse_cache;
+import :input_stream;
 import :print;
 import :timer;
+import :statistics;
+import :perf_counters;
+import :allocations;
+import :arena;
+import :cancellation;
+import :watchdog;
+import :benchmark_environment;
+import :trace;
+import :report;
+import :options;
+import :registry;
+import :thread_pool;
 import :split_string_view;
+import :line_index;
 
 namespace advent {
     namespace impl {
@@ -24,6 +40,44 @@ namespace advent {
             }));
         }
 
+        /* This would plausibly be a good option for a 'cvl::expand_loop'. */
+        consteval auto count_parts_to_solve() -> std::size_t {
+            auto index = 0uz;
+
+            while (true) {
+                if (not impl::part_has_solver(index)) {
+                    return index;
+                }
+
+                ++index;
+            }
+        }
+
+        /*
+            Besides its reference solver, a part may have any number
+            of named variants, such as a faster but trickier solver,
+            each of which is kept in its own 'part_variant_storage'.
+        */
+        template<std::size_t Index, std::size_t Variant>
+        struct part_variant_storage;
+
+        consteval auto part_variant_storage_of(std::size_t index, std::size_t variant) -> std::meta::info {
+            return substitute(^^impl::part_variant_storage, {
+                std::meta::reflect_constant(index),
+                std::meta::reflect_constant(variant)
+            });
+        }
+
+        consteval auto count_part_variants(std::size_t index) -> std::size_t {
+            auto variant = 0uz;
+
+            while (is_complete_type(impl::part_variant_storage_of(index, variant))) {
+                ++variant;
+            }
+
+            return variant;
+        }
+
         template<std::meta::info Solver, std::meta::info... TemplateArgs>
         struct part_solver_storage_member {};
 
@@ -74,10 +128,19 @@ namespace advent {
                         std::forward<Input>(input)
                     );
                 }
-            } else if constexpr (std::convertible_to<Input, std::string_view>) {
+            } else if constexpr (std::convertible_to<Input, std::string_view> && impl::can_solve_with_input<advent::split_string_view, Solver, TemplateArgs...>) {
                 return impl::solver_function<advent::split_string_view, Solver, TemplateArgs...>(
                     advent::views::split_lines(std::forward<Input>(input))
                 );
+            } else if constexpr (std::convertible_to<Input, std::string_view>) {
+                /*
+                    NOTE: Lines are only indexed up front for solvers which
+                    need more than a forward range, e.g. to count them or to
+                    split them up between threads, since it costs a little more.
+                */
+                return impl::solver_function<advent::indexed_lines, Solver, TemplateArgs...>(
+                    advent::views::index_lines(std::forward<Input>(input))
+                );
             } else {
                 static_assert(false, "Unable to call solver with provided input");
             }
@@ -86,11 +149,7 @@ namespace advent {
         struct solver_info {
             std::vector<std::meta::info> _info;
 
-            consteval explicit solver_info(std::size_t index) {
-                const auto storage = substitute(^^impl::part_solver_storage, {
-                    std::meta::reflect_constant(index)
-                });
-
+            consteval explicit solver_info(std::meta::info storage) {
                 const auto member = nonstatic_data_members_of(
                     storage, std::meta::access_context::unchecked()
                 )[0];
@@ -106,6 +165,23 @@ namespace advent {
                 }
             }
 
+            consteval explicit solver_info(std::size_t index)
+            :
+                solver_info(substitute(^^impl::part_solver_storage, {
+                    std::meta::reflect_constant(index)
+                }))
+            {}
+
+            consteval explicit solver_info(std::size_t index, std::size_t variant)
+            :
+                solver_info(impl::part_variant_storage_of(index, variant))
+            {}
+
+            /* The name of the solver itself, such as 'count_stones_after_iterations'. */
+            consteval auto solver_name(this const solver_info &self) -> std::string_view {
+                return identifier_of(self._info.front());
+            }
+
             consteval auto solver_function_with_template_args(
                 this const solver_info &self,
 
@@ -126,6 +202,14 @@ namespace advent {
                 return substitute(^^impl::solver_function, args);
             }
 
+            consteval auto accepts_input(this const solver_info &self, std::meta::info input_type) -> bool {
+                auto args = std::vector{input_type};
+
+                args.append_range(self._info);
+
+                return extract<bool>(substitute(^^impl::can_solve_with_input, args));
+            }
+
             consteval auto solver_function(this const solver_info &self, std::meta::info input_type) -> std::meta::info {
                 auto args = std::vector{input_type};
 
@@ -135,6 +219,39 @@ namespace advent {
             }
         };
 
+        consteval auto solver_storage_member_type(const std::meta::info solver, const auto &... template_args) -> std::meta::info {
+            return substitute(^^impl::part_solver_storage_member, {
+                std::meta::reflect_constant(solver),
+
+                std::meta::reflect_constant(
+                    std::meta::reflect_constant(template_args)
+                )...
+            });
+        }
+
+        consteval auto define_solver_storage(const std::meta::info storage, const std::meta::info solver, const auto &... template_args) -> void {
+            define_aggregate(storage, {
+                data_member_spec(impl::solver_storage_member_type(solver, template_args...), {
+                    .name = "dummy_field"
+                })
+            });
+        }
+
+        /* As with 'define_solver_storage', but also annotated with the variant's name. */
+        consteval auto define_variant_storage(const std::meta::info storage, std::string_view name, const std::meta::info solver, const auto &... template_args) -> void {
+            define_aggregate(storage, {
+                data_member_spec(impl::solver_storage_member_type(solver, template_args...), {
+                    .name = "dummy_field",
+
+                    .annotations = {
+                        std::meta::reflect_constant(
+                            std::define_static_string(name)
+                        )
+                    }
+                })
+            });
+        }
+
         consteval auto find_example_data() -> std::string_view {
             for (const auto member : members_of(^^::, std::meta::access_context::unprivileged())) {
                 if (not has_identifier(member)) {
@@ -161,11 +278,86 @@ namespace advent {
             throw std::meta::exception("Unable to find example data", ^^impl::find_example_data);
         }
 
+        /* The name of the input embedded by 'advent/embedded_input.hpp'. */
+        constexpr inline std::string_view EmbeddedInputName = "advent_embedded_input";
+
+        consteval auto find_embedded_input_member() -> std::optional<std::meta::info> {
+            for (const auto member : members_of(^^::, std::meta::access_context::unprivileged())) {
+                if (has_identifier(member) && identifier_of(member) == EmbeddedInputName) {
+                    return member;
+                }
+            }
+
+            return std::nullopt;
+        }
+
+        consteval auto has_embedded_input() -> bool {
+            return impl::find_embedded_input_member().has_value();
+        }
+
+        /* NOTE: We leave off the null terminator that was added to the embedded array. */
+        template<std::meta::info Array>
+        constexpr inline auto embedded_input_view = std::string_view([: Array :], sizeof([: Array :]) - 1);
+
+        consteval auto find_embedded_input() -> std::string_view {
+            const auto member = impl::find_embedded_input_member();
+            if (not member.has_value()) {
+                throw std::meta::exception("No input was embedded", ^^impl::find_embedded_input);
+            }
+
+            return extract<const std::string_view &>(substitute(^^impl::embedded_input_view, {
+                std::meta::reflect_constant(*member)
+            }));
+        }
+
         template<std::size_t Index>
         struct part_print_string_storage;
 
+        struct input_parser_storage;
+
+        consteval auto input_has_parser() -> bool {
+            return is_complete_type(^^impl::input_parser_storage);
+        }
+
     }
 
+    /*
+        Some days parse their input into a model which
+        is then used by each of their parts. For those
+        days, a parser may be registered with 'is_parsed_by'
+        so that the input is only parsed once and then the
+        resulting model is shared between each part.
+
+        When a parser has been registered, each part's
+        solver is called with the parsed model instead
+        of with the raw input.
+    */
+    export struct input_parser {
+        static consteval auto is_parsed_by(const std::meta::info parser, const auto &... template_args) -> void {
+            impl::define_solver_storage(^^impl::input_parser_storage, parser, template_args...);
+        }
+
+        static consteval auto has_parser() -> bool {
+            return impl::input_has_parser();
+        }
+
+        /* Whether the parser may be called with 'input_type' as is, rather than as lines split from it. */
+        static consteval auto accepts_input(std::meta::info input_type) -> bool {
+            return impl::solver_info(^^impl::input_parser_storage).accepts_input(input_type);
+        }
+
+        static consteval auto parser_function(std::meta::info input_type) -> std::meta::info {
+            return impl::solver_info(^^impl::input_parser_storage).solver_function(input_type);
+        }
+
+        template<typename Input = std::string_view>
+        static constexpr auto operator ()(Input &&input = impl::find_example_data()) -> decltype(auto) {
+            return [: parser_function(^^Input) :](std::forward<Input>(input));
+        }
+    };
+
+    export constexpr inline auto input = advent::input_parser{};
+
     /*
         NOTE: Each 'part' having its own type allows us to
         act like a normal function when called, which is
@@ -179,31 +371,58 @@ namespace advent {
         }
 
         static consteval auto is_solved_by(const std::meta::info solver, const auto &... template_args) -> void {
-            const auto storage = ^^impl::part_solver_storage<Index>;
-
-            const auto member_type = substitute(^^impl::part_solver_storage_member, {
-                std::meta::reflect_constant(solver),
-
-                std::meta::reflect_constant(
-                    std::meta::reflect_constant(template_args)
-                )...
-            });
-
-            define_aggregate(storage, {
-                data_member_spec(member_type, {
-                    .name = "dummy_field"
-                })
-            });
+            impl::define_solver_storage(^^impl::part_solver_storage<Index>, solver, template_args...);
         }
 
         static consteval auto has_solver() -> bool {
             return is_complete_type(^^impl::part_solver_storage<Index>);
         }
 
+        /* Whether the solver may be called with 'input_type' as is, rather than as lines split from it. */
+        static consteval auto accepts_input(std::meta::info input_type) -> bool {
+            return impl::solver_info(Index).accepts_input(input_type);
+        }
+
         static consteval auto solver_function(std::meta::info input_type) -> std::meta::info {
             return impl::solver_info(Index).solver_function(input_type);
         }
 
+        /*
+            Registers another solver for this part, alongside the one
+            given to 'is_solved_by', which stays the reference solver.
+
+            A day may check every variant against the reference solver on
+            the example data with 'variants_agree_on_example_data', and
+            may benchmark them on the real input by running with '--variants'.
+        */
+        static consteval auto is_also_solved_by(std::string_view name, const std::meta::info solver, const auto &... template_args) -> void {
+            const auto storage = impl::part_variant_storage_of(Index, impl::count_part_variants(Index));
+
+            impl::define_variant_storage(storage, name, solver, template_args...);
+        }
+
+        static consteval auto num_variants() -> std::size_t {
+            return impl::count_part_variants(Index);
+        }
+
+        static consteval auto solver_name() -> std::string_view {
+            return impl::solver_info(Index).solver_name();
+        }
+
+        static consteval auto variant_name(std::size_t variant) -> std::string_view {
+            const auto member = nonstatic_data_members_of(
+                impl::part_variant_storage_of(Index, variant), std::meta::access_context::unchecked()
+            )[0];
+
+            return extract<const char *>(
+                annotations_of(member)[0]
+            );
+        }
+
+        static consteval auto variant_solver_function(std::size_t variant, std::meta::info input_type) -> std::meta::info {
+            return impl::solver_info(Index, variant).solver_function(input_type);
+        }
+
         static consteval auto is_printed_with(std::string_view fmt) -> void {
             const auto storage = ^^impl::part_print_string_storage<Index>;
 
@@ -246,9 +465,66 @@ namespace advent {
             );
         }
 
+        /* Solves this part from the model produced by the registered input parser. */
+        template<typename Parsed>
+        static constexpr auto solve_parsed(const Parsed &parsed) -> decltype(auto) {
+            return [: solver_function(^^const Parsed &) :](parsed);
+        }
+
         template<typename Input = std::string_view>
         static constexpr auto operator ()(Input &&input = impl::find_example_data()) -> decltype(auto) {
-            return [: solver_function(^^Input) :](std::forward<Input>(input));
+            static constexpr auto HasParser = [](auto) {
+                return impl::input_has_parser();
+            }(^^Input);
+
+            if constexpr (HasParser) {
+                return part::solve_parsed(advent::input(std::forward<Input>(input)));
+            } else {
+                return [: solver_function(^^Input) :](std::forward<Input>(input));
+            }
+        }
+
+        /* As with calling this part, but solved by the variant registered 'Variant'-th. */
+        template<std::size_t Variant, typename Input = std::string_view>
+        static constexpr auto solve_variant(Input &&input = impl::find_example_data()) -> decltype(auto) {
+            static constexpr auto HasParser = [](auto) {
+                return impl::input_has_parser();
+            }(^^Input);
+
+            if constexpr (HasParser) {
+                const auto parsed = advent::input(std::forward<Input>(input));
+
+                using Parsed = std::remove_cvref_t<decltype(parsed)>;
+
+                return [: variant_solver_function(Variant, ^^const Parsed &) :](parsed);
+            } else {
+                return [: variant_solver_function(Variant, ^^Input) :](std::forward<Input>(input));
+            }
+        }
+
+        /*
+            Whether each variant gives the same answer on the example
+            data as the reference solver does, for a day to 'static_assert'.
+
+            NOTE: This is left for each day to opt into, since some parts,
+            even on the example data, take far too long to solve at compile
+            time, let alone once for the reference solver and each variant.
+        */
+        template<typename Input = std::string_view>
+        static consteval auto variants_agree_on_example_data(const Input input = impl::find_example_data()) -> bool {
+            const auto reference = part{}(input);
+
+            template for (constexpr auto Variant : std::views::indices(part::num_variants())) {
+                if (part::solve_variant<Variant>(input) != reference) {
+                    throw std::meta::exception(
+                        std::string("Variant '") + std::string(part::variant_name(Variant)) + "' disagrees with the reference solver on the example data",
+
+                        ^^variants_agree_on_example_data
+                    );
+                }
+            }
+
+            return true;
         }
 
         /*
@@ -261,6 +537,21 @@ namespace advent {
         */
         template<auto... TemplateArgs, typename Input = std::string_view>
         static constexpr auto with_template_args(Input &&input = impl::find_example_data()) -> decltype(auto) {
+            static constexpr auto HasParser = [](auto) {
+                return impl::input_has_parser();
+            }(^^Input);
+
+            if constexpr (HasParser) {
+                const auto parsed = advent::input(std::forward<Input>(input));
+
+                return part::_solve_with_template_args<TemplateArgs...>(parsed);
+            } else {
+                return part::_solve_with_template_args<TemplateArgs...>(std::forward<Input>(input));
+            }
+        }
+
+        template<auto... TemplateArgs, typename Input>
+        static constexpr auto _solve_with_template_args(Input &&input) -> decltype(auto) {
             static constexpr auto SolverFunction = impl::solver_info(Index).solver_function_with_template_args(
                 {std::meta::reflect_constant(TemplateArgs)...},
 
@@ -277,126 +568,1076 @@ namespace advent {
     namespace impl {
 
         template<advent::part Part, typename Solution>
-        constexpr auto perform_print(Solution &&solution, const auto duration) {
+        constexpr auto perform_print(Solution &&solution, const advent::scaled_duration duration) {
             static constexpr auto PrintString = Part.print_string();
 
-            if (duration >= std::chrono::seconds(1)) {
-                using seconds = std::chrono::duration<std::float64_t>;
+            advent::println(PrintString, std::forward<Solution>(solution), duration);
+        }
 
-                const auto scaled = std::chrono::duration_cast<seconds>(duration);
+        constexpr auto print_statistics(const advent::timing_statistics &statistics) {
+            advent::println(
+                "\tmin {:.3}, median {:.3}, mean {:.3}, stddev {:.3}, p99 {:.3}\t({} iterations)",
 
-                advent::println(PrintString, std::forward<Solution>(solution), scaled);
-            } else if (duration >= std::chrono::milliseconds(1)) {
-                using milliseconds = std::chrono::duration<std::float64_t, std::milli>;
+                advent::scaled_duration(statistics.min),
+                advent::scaled_duration(statistics.median),
+                advent::scaled_duration(statistics.mean),
+                advent::scaled_duration(statistics.stddev),
+                advent::scaled_duration(statistics.p99),
 
-                const auto scaled = std::chrono::duration_cast<milliseconds>(duration);
+                statistics.num_samples
+            );
+        }
 
-                advent::println(PrintString, std::forward<Solution>(solution), scaled);
+        constexpr auto open_perf_counters() -> advent::perf_counters {
+            if consteval {
+                return advent::perf_counters();
             } else {
-                using microseconds = std::chrono::duration<std::float64_t, std::micro>;
+                return advent::perf_counters::open();
+            }
+        }
+
+        constexpr auto print_counts(const advent::perf_counts &counts) {
+            if (not counts.has_any()) {
+                return;
+            }
+
+            std::vector<std::string> descriptions;
 
-                const auto scaled = std::chrono::duration_cast<microseconds>(duration);
+            if (const auto ipc = counts.instructions_per_cycle(); ipc.has_value()) {
+                descriptions.push_back(std::format("IPC {:.2f}", *ipc));
+            }
+
+            static constexpr std::pair<advent::perf_event, std::string_view> MissRates[] = {
+                {advent::perf_event::branch_misses, "branch misses"},
+                {advent::perf_event::l1d_misses,    "L1d misses"},
+                {advent::perf_event::llc_misses,    "LLC misses"},
+            };
+
+            for (const auto [event, name] : MissRates) {
+                if (const auto rate = counts.per_kilo_instruction(event); rate.has_value()) {
+                    descriptions.push_back(std::format("{} {:.2f}/k instructions", name, *rate));
+                }
+            }
 
-                advent::println(PrintString, std::forward<Solution>(solution), scaled);
+            if (const auto page_faults = counts[advent::perf_event::page_faults]; page_faults.has_value()) {
+                descriptions.push_back(std::format("page faults {}", *page_faults));
             }
+
+            advent::println("\t{}", descriptions | std::views::join_with(std::string_view(", ")) | std::ranges::to<std::string>());
         }
 
-    }
+        constexpr auto print_allocations(const advent::allocation_counts &allocations) {
+            if (not advent::allocation_tracker::is_installed()) {
+                return;
+            }
 
-    export template<advent::part Part>
-    constexpr auto print_solution(const std::string &data) -> void {
-        advent::timer timer;
+            advent::println(
+                "\t{} allocations, {} frees, {} bytes allocated, {} bytes peak",
 
-        const auto solve = [&]() -> decltype(auto) {
-            static constexpr auto SolverFunction = Part.solver_function(^^const std::string &);
+                allocations.num_allocations,
+                allocations.num_frees,
+                allocations.bytes_allocated,
+                allocations.peak_live_bytes
+            );
+        }
 
-            auto _ = timer.measure_scope();
+        /*
+            Solves once, or many times when benchmarking, and
+            returns the last result along with its timings.
+        */
+        template<typename Solve>
+        constexpr auto measure(const advent::run_options &options, Solve &&solve) {
+            using Result = std::remove_cvref_t<std::invoke_result_t<Solve &>>;
 
-            return [: SolverFunction :](data);
-        };
+            struct measurement {
+                Result result;
 
-        /* We use this lambda to make our evaluation order more explicit. */
-        const auto perform_print = [&](auto &&solution) {
-            impl::perform_print<Part>(std::forward<decltype(solution)>(solution), timer.last_measured_duration());
-        };
+                advent::timing_statistics statistics;
 
-        perform_print(solve());
-    }
+                /* Averaged over every timed iteration, and empty unless asked for. */
+                advent::perf_counts counts;
 
-    /* 'argv' is a pointer to a const pointer to a const 'char'. */
-    export constexpr auto puzzle_data(int argc, const char * const *argv) -> std::optional<std::string> {
-        /* NOTE: If we need more complex logic, we can put the args in a span. */
-        if (argc < 2) {
-            return std::nullopt;
-        }
+                /* Averaged over every timed iteration, and empty unless the tracker is linked in. */
+                advent::allocation_counts allocations;
 
-        const auto fp = std::fopen(argv[1], "r");
-        if (fp == nullptr) {
-            return std::nullopt;
-        }
+                /* The duration of every timed iteration, in the order they were timed. */
+                std::vector<advent::timing_statistics::duration> samples;
 
-        advent::scope_guard _ = [&]() {
-            std::fclose(fp);
-        };
+                /* Whether we ran over our budget, in which case our result is meaningless. */
+                bool timed_out = false;
+            };
 
-        /* Get the size of the file. */
-        if (std::fseek(fp, 0, SEEK_END) < 0) {
-            return std::nullopt;
-        }
+            advent::timer timer;
 
-        const auto pos = std::ftell(fp);
-        if (pos < 0) {
-            return std::nullopt;
+            advent::allocation_tracker allocation_tracker;
+
+            auto counters = options.count_events ? impl::open_perf_counters() : advent::perf_counters();
+
+            const auto timed_solve = [&]() -> decltype(auto) {
+                auto _ = timer.measure_scope();
+
+                return std::invoke(solve);
+            };
+
+            const auto [warmup_iterations, iterations] = [&]() {
+                if (options.is_benchmarking()) {
+                    return std::pair(options.warmup_iterations, options.bench_iterations);
+                }
+
+                return std::pair(0uz, 1uz);
+            }();
+
+            for (auto _ : std::views::iota(0uz, warmup_iterations)) {
+                advent::do_not_optimize(timed_solve());
+            }
+
+            std::vector<decltype(timer.last_measured_duration())> samples;
+            samples.reserve(iterations);
+
+            Result result = [&]() -> Result {
+                /* NOTE: Counting is left out of warming up, but spans every timed iteration. */
+                auto _ = counters.measure_scope();
+                auto _ = allocation_tracker.measure_scope();
+
+                for (auto _ : std::views::iota(1uz, iterations)) {
+                    advent::do_not_optimize(timed_solve());
+
+                    samples.push_back(timer.last_measured_duration());
+                }
+
+                return timed_solve();
+            }();
+
+            samples.push_back(timer.last_measured_duration());
+
+            return measurement{
+                std::move(result),
+
+                advent::timing_statistics::from_samples(samples),
+
+                counters.last_measured_counts() / iterations,
+
+                allocation_tracker.last_measured_counts() / iterations,
+
+                std::vector(std::from_range, samples | std::views::transform([](const auto sample) {
+                    return std::chrono::duration_cast<advent::timing_statistics::duration>(sample);
+                }))
+            };
         }
 
-        const auto file_size = static_cast<std::size_t>(pos);
+        constexpr auto print_timing(const advent::run_options &options, const auto &measurement) {
+            if (options.is_benchmarking()) {
+                impl::print_statistics(measurement.statistics);
+            }
 
-        if (std::fseek(fp, 0, SEEK_SET) < 0) {
-            return std::nullopt;
+            impl::print_counts(measurement.counts);
+            impl::print_allocations(measurement.allocations);
         }
 
-        std::string file_contents;
-        file_contents.resize_and_overwrite(file_size, [&](char *data, const std::size_t size) {
-            return std::fread(data, 1, size, fp);
-        });
+        constexpr auto write_record(const advent::run_options &options, const std::size_t part, std::string answer, const auto &measurement) {
+            advent::write_record(options.format, advent::timing_record{
+                .puzzle = options.puzzle,
+                .part   = part,
+                .answer = std::move(answer),
 
-        if (file_contents.size() != file_size) {
-            return std::nullopt;
+                .statistics = measurement.statistics,
+                .samples    = measurement.samples,
+
+                .input_bytes = options.input_bytes,
+            });
         }
 
-        return file_contents;
     }
 
     /*
-        NOTE: We need a dependent name so that we don't
-        evaluate our stateful metaprogramming too early.
+        Parses the input with the registered parser,
+        printing how long the parsing took, and returns
+        the model to be handed to each part's solver.
+
+        If given an arena, the model is allocated from it,
+        and so the arena must outlive the returned model.
     */
-    export template<typename DependentName = int>
-    constexpr auto solve_puzzles(int argc, const char * const *argv) -> int {
-        const auto data = advent::puzzle_data(argc, argv);
-        if (not data.has_value()) {
-            advent::println("Unable to read puzzle data!");
+    export template<typename Input>
+    constexpr auto parse_input(const Input &data, const advent::run_options &options = {}, advent::arena *arena = nullptr) {
+        static constexpr auto ParserFunction = advent::input.parser_function(^^const Input &);
 
-            return 1;
-        }
+        auto measurement = impl::measure(options, [&]() {
+            const auto _ = advent::trace_scope("parse");
 
-        /* This would plausibly be a good option for a 'cvl::expand_loop'. */
-        static constexpr auto NumPartsToSolve  = [](auto) {
-            auto index = 0uz;
+            if (arena == nullptr) {
+                return [: ParserFunction :](data);
+            }
 
-            while (true) {
-                if (not impl::part_has_solver(index)) {
-                    return index;
-                }
+            /* NOTE: Each earlier iteration's model has been destroyed by now. */
+            arena->release();
 
-                ++index;
-            }
-        }(^^DependentName);
+            const auto _ = arena->use_scope();
+
+            return [: ParserFunction :](data);
+        });
+
+        if (options.format != advent::output_format::human) {
+            impl::write_record(options, 0, std::string(), measurement);
 
-        template for (constexpr auto Index : std::views::indices(NumPartsToSolve)) {
-            advent::print_solution<advent::part<Index>{}>(*data);
+            return std::move(measurement.result);
         }
 
-        return 0;
+        advent::println("Parsed input\t\t(in {:.3})", advent::scaled_duration(measurement.statistics.median));
+        impl::print_timing(options, measurement);
+
+        return std::move(measurement.result);
+    }
+
+    namespace impl {
+
+        /*
+            Parses the input as 'advent::parse_input' does, except that
+            when asked to and our model supports it, we first try to map
+            in a model cached from this same input by an earlier run, and
+            otherwise cache the model we parse for the next run.
+        */
+        template<typename Input>
+        auto parse_or_load_input(const Input &data, const advent::run_options &options, advent::arena &arena) {
+            using Parsed = decltype(advent::parse_input(data, options, &arena));
+
+            if constexpr (advent::cacheable<Parsed> && std::convertible_to<const Input &, std::string_view>) {
+                if (options.cache_directory != nullptr) {
+                    const auto input = std::string_view(data);
+                    const auto path  = advent::parse_cache_path(options.cache_directory, options.puzzle, input);
+
+                    advent::timer timer;
+
+                    auto cached = [&]() {
+                        auto _ = timer.measure_scope();
+
+                        return advent::load_cached<Parsed>(path, input);
+                    }();
+
+                    if (cached.has_value()) {
+                        if (options.format == advent::output_format::human) {
+                            advent::println("Loaded parsed input from cache\t(in {:.3})", advent::scaled_duration(timer.last_measured_duration()));
+                        }
+
+                        return std::move(*cached);
+                    }
+
+                    auto parsed = advent::parse_input(data, options, &arena);
+
+                    if (not advent::store_cached(path, input, parsed) && options.format == advent::output_format::human) {
+                        advent::println("Unable to cache parsed input at '{}'!", path.string());
+                    }
+
+                    return parsed;
+                }
+            }
+
+            return advent::parse_input(data, options, &arena);
+        }
+
+    }
+
+    namespace impl {
+
+        constexpr auto part_trace_name(const std::size_t index) -> std::string_view {
+            static constexpr std::string_view Names[] = {
+                "part one",
+                "part two",
+            };
+
+            if (index >= std::size(Names)) {
+                return "part";
+            }
+
+            return Names[index];
+        }
+
+        constexpr auto part_name(const std::size_t index) -> std::string_view {
+            static constexpr std::string_view Names[] = {
+                "Part one",
+                "Part two",
+            };
+
+            if (index >= std::size(Names)) {
+                return "Part";
+            }
+
+            return Names[index];
+        }
+
+        template<advent::part Part, typename Input>
+        constexpr auto solve_part(const Input &input, const advent::run_options &options) {
+            static constexpr auto SolverFunction = Part.solver_function(^^const Input &);
+
+            /* Everything a solver allocates through 'advent::arena_allocator' is freed after each solve. */
+            advent::arena arena;
+
+            advent::cancellation_source cancellation;
+
+            std::optional<advent::watchdog> watchdog;
+            if !consteval {
+                if (options.has_budget()) {
+                    watchdog.emplace(impl::part_name(Part.index()), options.part_budget, cancellation, options.format);
+                }
+            }
+
+            /*
+                NOTE: Solvers receive the input by const reference,
+                so any solver which needs to mutate its input takes
+                it by value, and so gets a fresh copy on every solve.
+            */
+            auto measurement = impl::measure(options, [&]() {
+                const auto _ = advent::trace_scope(impl::part_trace_name(Part.index()));
+
+                arena.release();
+
+                const auto _ = arena.use_scope();
+                const auto _ = cancellation.use_scope();
+
+                auto result = [: SolverFunction :](input);
+
+                if (watchdog.has_value()) {
+                    watchdog->complete_iteration();
+                }
+
+                return result;
+            });
+
+            if (watchdog.has_value()) {
+                measurement.timed_out = watchdog->stop();
+            }
+
+            return measurement;
+        }
+
+        /* Prints the part's solution, returning whether it was solved within its budget. */
+        template<advent::part Part>
+        constexpr auto print_measurement(const auto &measurement, const advent::run_options &options) -> bool {
+            if (options.format != advent::output_format::human) {
+                const auto answer = measurement.timed_out ? std::string("timeout") : std::format("{}", measurement.result);
+
+                impl::write_record(options, Part.index() + 1, answer, measurement);
+                advent::flush_output();
+
+                return not measurement.timed_out;
+            }
+
+            if (measurement.timed_out) {
+                advent::println("{} timed out\t(in {:.3})", impl::part_name(Part.index()), advent::scaled_duration(measurement.statistics.median));
+                advent::flush_output();
+
+                return false;
+            }
+
+            impl::perform_print<Part>(measurement.result, measurement.statistics.median);
+            impl::print_timing(options, measurement);
+
+            /* NOTE: So that each part's solution shows up as soon as it's solved. */
+            advent::flush_output();
+
+            return true;
+        }
+
+        /*
+            Solves each part on its own thread, all sharing the same
+            immutable input, and then prints their solutions in order.
+        */
+        template<std::size_t NumParts, typename Input>
+        constexpr auto print_solutions_concurrently(const Input &input, const advent::run_options &options) -> bool {
+            return [&]<std::size_t... Indices>(std::index_sequence<Indices...>) {
+                std::tuple<
+                    std::optional<decltype(impl::solve_part<advent::part<Indices>{}>(input, options))>...
+                > measurements;
+
+                {
+                    /* NOTE: Each thread is joined at the end of this scope. */
+                    const std::jthread threads[] = {
+                        std::jthread([&]() {
+                            std::get<Indices>(measurements).emplace(
+                                impl::solve_part<advent::part<Indices>{}>(input, options)
+                            );
+                        })...
+                    };
+                }
+
+                /* NOTE: Braced initialization prints each in order. */
+                const bool solved[] = {
+                    true,
+
+                    impl::print_measurement<advent::part<Indices>{}>(*std::get<Indices>(measurements), options)...
+                };
+
+                return std::ranges::all_of(solved, std::identity{});
+            }(std::make_index_sequence<NumParts>{});
+        }
+
+    }
+
+    namespace impl {
+
+        template<advent::part Part, std::size_t Variant, typename Input>
+        constexpr auto solve_variant(const Input &input, const advent::run_options &options) {
+            static constexpr auto SolverFunction = Part.variant_solver_function(Variant, ^^const Input &);
+
+            advent::arena arena;
+
+            return impl::measure(options, [&]() {
+                const auto _ = advent::trace_scope(Part.variant_name(Variant));
+
+                arena.release();
+
+                const auto _ = arena.use_scope();
+
+                return [: SolverFunction :](input);
+            });
+        }
+
+        /*
+            Solves each part with its reference solver and then with each of
+            its variants, printing their timings side by side, and returns
+            whether every variant agreed with its reference solver's answer.
+        */
+        template<std::size_t NumParts, typename Input>
+        constexpr auto print_variant_comparison(const Input &input, const advent::run_options &options) -> bool {
+            bool all_agree = true;
+
+            advent::println("Part\tSolver\t\tMedian time\tSpeedup\tSolution");
+
+            template for (constexpr auto Index : std::views::indices(NumParts)) {
+                static constexpr auto Part = advent::part<Index>{};
+
+                const auto reference        = impl::solve_part<Part>(input, options);
+                const auto reference_answer = std::format("{}", reference.result);
+
+                advent::println(
+                    "{}\t{}\t\t{:.3}\t\t{}",
+
+                    Index + 1, Part.solver_name(), advent::scaled_duration(reference.statistics.median), reference_answer
+                );
+
+                template for (constexpr auto Variant : std::views::indices(Part.num_variants())) {
+                    const auto measurement = impl::solve_variant<Part, Variant>(input, options);
+                    const auto answer      = std::format("{}", measurement.result);
+
+                    const auto agrees = (answer == reference_answer);
+                    all_agree = all_agree && agrees;
+
+                    /* NOTE: Anything too quick to time is simply treated as taking a nanosecond. */
+                    const auto speedup = reference.statistics.median / std::max(measurement.statistics.median, advent::timing_statistics::duration(1));
+
+                    advent::println(
+                        "{}\t{}\t\t{:.3}\t{:.2f}x\t{}{}",
+
+                        Index + 1, Part.variant_name(Variant), advent::scaled_duration(measurement.statistics.median), speedup, answer,
+
+                        agrees ? "" : "\t<-- disagrees"
+                    );
+                }
+            }
+
+            return all_agree;
+        }
+
+    }
+
+    /* Returns whether the part was solved within its budget. */
+    export template<advent::part Part, typename Input>
+    constexpr auto print_solution(const Input &input, const advent::run_options &options = {}) -> bool {
+        return impl::print_measurement<Part>(impl::solve_part<Part>(input, options), options);
+    }
+
+    /*
+        The contents of our puzzle input, either mapped
+        directly from a file or read into a buffer we own.
+    */
+    export struct puzzle_input {
+        std::variant<advent::mapped_file, std::string> _storage;
+
+        constexpr std::string_view view(this const puzzle_input &self) {
+            return std::visit([](const auto &storage) {
+                return std::string_view(storage);
+            }, self._storage);
+        }
+
+        constexpr std::size_t size(this const puzzle_input &self) {
+            return self.view().size();
+        }
+    };
+
+    /*
+        Reads the puzzle input at 'path', where a path of '-'
+        refers to our standard input, which may also be a pipe.
+    */
+    export constexpr auto puzzle_data(const char *path) -> std::optional<advent::puzzle_input> {
+        const auto fd = advent::open_input(path);
+        if (fd < 0) {
+            return std::nullopt;
+        }
+
+        advent::scope_guard _ = [&]() {
+            ::close(fd);
+        };
+
+        /* Prefer mapping the file so that we don't need to copy it. */
+        if (auto mapped = advent::mapped_file::map_descriptor(fd); mapped.has_value()) {
+            return advent::puzzle_input{std::move(*mapped)};
+        }
+
+        /* Otherwise, such as for pipes, we fall back to reading the whole thing into a buffer. */
+        auto contents = advent::read_descriptor(fd);
+        if (not contents.has_value()) {
+            return std::nullopt;
+        }
+
+        return advent::puzzle_input{std::move(*contents)};
+    }
+
+    /* 'argv' is a pointer to a const pointer to a const 'char'. */
+    export constexpr auto puzzle_data(int argc, const char * const *argv) -> std::optional<advent::puzzle_input> {
+        const auto options = advent::parse_run_options(argc, argv);
+        if (not options.has_value()) {
+            return std::nullopt;
+        }
+
+        return advent::puzzle_data(options->input_path);
+    }
+
+    namespace impl {
+
+        /* Names 'T', but in a way that depends on 'DependentName'. */
+        template<typename T, typename DependentName>
+        struct dependent_type {
+            using type = T;
+        };
+
+        /*
+            NOTE: The jobs below take a 'DependentName' so
+            that we don't evaluate our stateful metaprogramming
+            too early, and so cast their input to a dependent type.
+        */
+
+        template<typename DependentName>
+        auto parse_job(const std::string_view input) -> advent::day_jobs::parse_result {
+            using Input = impl::dependent_type<std::string_view, DependentName>::type;
+
+            auto measurement = impl::measure(advent::run_options{}, [&]() {
+                return advent::input(static_cast<const Input &>(input));
+            });
+
+            using Parsed = std::remove_cvref_t<decltype(measurement.result)>;
+
+            return {
+                std::make_shared<const Parsed>(std::move(measurement.result)),
+
+                std::chrono::duration_cast<std::chrono::nanoseconds>(measurement.statistics.median)
+            };
+        }
+
+        template<typename DependentName, std::size_t Index>
+        auto solve_job(const std::string_view input, const void *parsed) -> advent::job_result {
+            using Input = impl::dependent_type<std::string_view, DependentName>::type;
+
+            static constexpr auto HasParser = [](auto) {
+                return impl::input_has_parser();
+            }(^^DependentName);
+
+            const auto measurement = [&]() {
+                if constexpr (HasParser) {
+                    using Parsed = std::remove_cvref_t<decltype(advent::input(static_cast<const Input &>(input)))>;
+
+                    return impl::solve_part<advent::part<Index>{}>(*static_cast<const Parsed *>(parsed), advent::run_options{});
+                } else {
+                    return impl::solve_part<advent::part<Index>{}>(static_cast<const Input &>(input), advent::run_options{});
+                }
+            }();
+
+            return {
+                std::format("{}", measurement.result),
+
+                std::chrono::duration_cast<std::chrono::nanoseconds>(measurement.statistics.median)
+            };
+        }
+
+        template<typename DependentName>
+        auto make_day_jobs() -> advent::day_jobs {
+            static constexpr auto NumParts = [](auto) {
+                return impl::count_parts_to_solve();
+            }(^^DependentName);
+
+            static constexpr auto HasParser = [](auto) {
+                return impl::input_has_parser();
+            }(^^DependentName);
+
+            advent::day_jobs jobs;
+
+            if constexpr (HasParser) {
+                jobs.parse = &impl::parse_job<DependentName>;
+            }
+
+            template for (constexpr auto Index : std::views::indices(NumParts)) {
+                jobs.solve_part.push_back(&impl::solve_job<DependentName, Index>);
+            }
+
+            return jobs;
+        }
+
+        /*
+            Registers our day's jobs as soon as we're loaded,
+            so that the runner for every day may find them.
+        */
+        template<typename DependentName>
+        struct day_registrar {
+            static inline const bool Registered = []() {
+                impl::registered_day_jobs() = impl::make_day_jobs<DependentName>();
+
+                return true;
+            }();
+        };
+
+    }
+
+    namespace impl {
+
+        /*
+            Solves a part with our embedded input entirely during constant evaluation.
+
+            NOTE: Real inputs can take far more evaluation than example data.
+            Should that exceed one of GCC's limits, the error will point here,
+            and the limits for embedded days may be raised in our 'CMakeLists.txt'.
+        */
+        template<typename DependentName, std::size_t Index>
+        consteval auto solve_embedded_input_at_compile_time() {
+            using Input = impl::dependent_type<std::string_view, DependentName>::type;
+
+            const auto solution = advent::part<Index>{}(static_cast<Input>(impl::find_embedded_input()));
+
+            using Solution = std::remove_cvref_t<decltype(solution)>;
+
+            if constexpr (std::integral<Solution>) {
+                return solution;
+            } else if constexpr (std::convertible_to<const Solution &, std::string_view>) {
+                /* NOTE: The solution's storage can't outlive constant evaluation, so we make it static. */
+                return std::string_view(std::define_static_string(std::string_view(solution)));
+            } else {
+                static_assert(false, "Only integral and string solutions may be solved at compile time");
+            }
+        }
+
+        template<typename DependentName>
+        auto print_embedded_solutions() -> int {
+            static constexpr auto NumParts = [](auto) {
+                return impl::count_parts_to_solve();
+            }(^^DependentName);
+
+            template for (constexpr auto Index : std::views::indices(NumParts)) {
+                static constexpr auto Solution = impl::solve_embedded_input_at_compile_time<DependentName, Index>();
+
+                /* We spent no time at all solving. */
+                impl::perform_print<advent::part<Index>{}>(Solution, std::chrono::nanoseconds::zero());
+            }
+
+            return 0;
+        }
+
+        /* Whether we were given more than a single input to solve. */
+        auto is_batch(const advent::run_options &options) -> bool {
+            if (options.has_many_inputs()) {
+                return true;
+            }
+
+            std::error_code error;
+
+            return std::filesystem::is_directory(options.input_path, error);
+        }
+
+        /* Expands any directories into the regular files within them. */
+        auto collect_batch_inputs(const std::span<const char * const> paths) -> std::vector<std::string> {
+            std::vector<std::string> inputs;
+
+            for (const auto path : paths) {
+                std::error_code error;
+                if (not std::filesystem::is_directory(path, error)) {
+                    inputs.emplace_back(path);
+
+                    continue;
+                }
+
+                std::vector<std::string> directory_inputs;
+                for (const auto &entry : std::filesystem::directory_iterator(path, error)) {
+                    if (entry.is_regular_file(error)) {
+                        directory_inputs.push_back(entry.path().string());
+                    }
+                }
+
+                std::ranges::sort(directory_inputs);
+
+                inputs.append_range(std::move(directory_inputs));
+            }
+
+            return inputs;
+        }
+
+        struct batch_result {
+            bool was_read = false;
+
+            std::size_t input_bytes = 0;
+
+            std::optional<std::chrono::nanoseconds> parse_duration;
+
+            std::vector<advent::job_result> parts;
+        };
+
+        auto print_batch_statistics(const std::string_view name, const std::span<const std::chrono::nanoseconds> durations) -> void {
+            const auto statistics = advent::timing_statistics::from_samples(durations);
+
+            advent::println(
+                "{}\tmin {:.3}, median {:.3}, mean {:.3}, p99 {:.3}, total {:.3}\t({} inputs)",
+
+                name,
+
+                advent::scaled_duration(statistics.min),
+                advent::scaled_duration(statistics.median),
+                advent::scaled_duration(statistics.mean),
+                advent::scaled_duration(statistics.p99),
+
+                advent::scaled_duration(std::ranges::fold_left(durations, std::chrono::nanoseconds{}, std::plus{})),
+
+                statistics.num_samples
+            );
+        }
+
+        auto print_batch(
+            const std::span<const std::string>        inputs,
+            const std::span<const impl::batch_result> results,
+            const advent::run_options                &options,
+            const std::chrono::nanoseconds            wall_duration
+        ) -> void {
+            if (options.format != advent::output_format::human) {
+                for (const auto [input, result] : std::views::zip(inputs, results)) {
+                    const auto write_one = [&](const std::size_t part, std::string answer, const std::chrono::nanoseconds duration) {
+                        advent::write_record(options.format, advent::timing_record{
+                            .puzzle = options.puzzle,
+                            .part   = part,
+                            .answer = std::move(answer),
+
+                            .statistics = advent::timing_statistics::from_samples(std::array{duration}),
+
+                            .input_bytes = result.input_bytes,
+                            .input       = input,
+                        });
+                    };
+
+                    if (result.parse_duration.has_value()) {
+                        write_one(0, std::string(), *result.parse_duration);
+                    }
+
+                    for (const auto [index, part] : result.parts | std::views::enumerate) {
+                        write_one(static_cast<std::size_t>(index) + 1, part.solution, part.duration);
+                    }
+                }
+
+                return;
+            }
+
+            advent::println("Input\tPart\tTime\t\tSolution");
+
+            for (const auto [input, result] : std::views::zip(inputs, results)) {
+                if (not result.was_read) {
+                    advent::println("{}\tUnable to read puzzle data!", input);
+
+                    continue;
+                }
+
+                if (result.parse_duration.has_value()) {
+                    advent::println("{}\tparse\t{:.3}", input, advent::scaled_duration(*result.parse_duration));
+                }
+
+                for (const auto [index, part] : result.parts | std::views::enumerate) {
+                    advent::println("{}\t{}\t{:.3}\t{}", input, index + 1, advent::scaled_duration(part.duration), part.solution);
+                }
+            }
+
+            /* NOTE: Not const, since filtering caches where it begins. */
+            auto solved = results | std::views::filter(&impl::batch_result::was_read);
+
+            advent::println();
+            advent::println("Solved {} of {} inputs", std::ranges::distance(solved), results.size());
+
+            const auto parse_durations = std::vector(std::from_range, solved | std::views::filter([](const impl::batch_result &result) {
+                return result.parse_duration.has_value();
+            }) | std::views::transform([](const impl::batch_result &result) {
+                return *result.parse_duration;
+            }));
+
+            if (not parse_durations.empty()) {
+                impl::print_batch_statistics("Parsing", parse_durations);
+            }
+
+            const auto num_parts = std::ranges::fold_left(solved | std::views::transform([](const impl::batch_result &result) {
+                return result.parts.size();
+            }), 0uz, [](const auto lhs, const auto rhs) {
+                return std::max(lhs, rhs);
+            });
+
+            for (const auto index : std::views::iota(0uz, num_parts)) {
+                const auto part_durations = std::vector(std::from_range, solved | std::views::transform([&](const impl::batch_result &result) {
+                    return result.parts[index].duration;
+                }));
+
+                impl::print_batch_statistics(std::format("Part {}", index + 1), part_durations);
+            }
+
+            advent::println("Wall time\t{:.3}", advent::scaled_duration(wall_duration));
+        }
+
+        /*
+            Solves each of many inputs, spreading them across a
+            single pool of threads, and reports on them together.
+
+            NOTE: Reusing the same threads for every input also
+            lets each reuse its allocator's caches between inputs.
+        */
+        auto solve_batch(const advent::day_jobs &jobs, const advent::run_options &options) -> int {
+            const auto inputs = impl::collect_batch_inputs(options.input_paths);
+            if (inputs.empty()) {
+                advent::println("No inputs found!");
+
+                return 1;
+            }
+
+            auto results = std::vector<impl::batch_result>(inputs.size());
+
+            advent::timer timer;
+
+            {
+                const auto num_threads = (options.num_threads > 0) ? options.num_threads : advent::thread_pool::default_num_workers();
+
+                auto pool = advent::thread_pool(num_threads);
+
+                auto _ = timer.measure_scope();
+
+                for (const auto [input, result] : std::views::zip(inputs, results)) {
+                    pool.submit([&jobs, &input = input, &result = result]() {
+                        const auto data = advent::puzzle_data(input.c_str());
+                        if (not data.has_value()) {
+                            return;
+                        }
+
+                        result.was_read    = true;
+                        result.input_bytes = data->size();
+
+                        auto parsed = advent::day_jobs::parsed_model(nullptr);
+                        if (jobs.has_parser()) {
+                            auto [model, duration] = jobs.parse(data->view());
+
+                            parsed                = std::move(model);
+                            result.parse_duration = duration;
+                        }
+
+                        result.parts.reserve(jobs.num_parts());
+                        for (const auto solve_part : jobs.solve_part) {
+                            result.parts.push_back(solve_part(data->view(), parsed.get()));
+                        }
+                    });
+                }
+
+                pool.wait();
+            }
+
+            impl::print_batch(inputs, results, options, timer.last_measured_duration());
+
+            const auto all_read = std::ranges::all_of(results, &impl::batch_result::was_read);
+
+            return all_read ? 0 : 1;
+        }
+
+        /*
+            Hands our input, line by line as it's read, to whatever
+            takes it first, which is either our parser or part one.
+            Everything after that gets the input once it's all read.
+        */
+        template<std::size_t NumParts, bool HasParser>
+        auto solve_streamed(advent::run_options &options) -> int {
+            auto stream = advent::input_stream::open(options.input_path);
+            if (not stream.has_value()) {
+                advent::println("Unable to read puzzle data!");
+
+                return 1;
+            }
+
+            /* NOTE: Until then, we can't know how large our input is. */
+            const auto finish_reading = [&]() {
+                stream->read_to_end();
+
+                options.input_bytes = stream->size();
+
+                if (stream->failed()) {
+                    advent::println("Unable to read puzzle data!");
+
+                    return false;
+                }
+
+                return true;
+            };
+
+            bool all_solved = true;
+
+            if constexpr (HasParser) {
+                advent::arena parse_arena;
+
+                const auto parsed = advent::parse_input(stream->lines(), options, &parse_arena);
+                if (not finish_reading()) {
+                    return 1;
+                }
+
+                if (options.solve_parts_concurrently) {
+                    return impl::print_solutions_concurrently<NumParts>(parsed, options) ? 0 : 1;
+                }
+
+                template for (constexpr auto Index : std::views::indices(NumParts)) {
+                    all_solved = advent::print_solution<advent::part<Index>{}>(parsed, options) && all_solved;
+                }
+            } else {
+                all_solved = advent::print_solution<advent::part_one>(stream->lines(), options);
+                if (not finish_reading()) {
+                    return 1;
+                }
+
+                template for (constexpr auto Index : std::views::iota(1uz, NumParts)) {
+                    all_solved = advent::print_solution<advent::part<Index>{}>(stream->view(), options) && all_solved;
+                }
+            }
+
+            return all_solved ? 0 : 1;
+        }
+
+    }
+
+    /*
+        NOTE: We need a dependent name so that we don't
+        evaluate our stateful metaprogramming too early.
+    */
+    export template<typename DependentName = int>
+    constexpr auto solve_puzzles(int argc, const char * const *argv, const std::source_location location = std::source_location::current()) -> int {
+        static constexpr auto HasEmbeddedInput = [](auto) {
+            return impl::has_embedded_input();
+        }(^^DependentName);
+
+        /* With our input solved at compile time, we just print the answers unless given another input. */
+        if constexpr (HasEmbeddedInput) {
+            if (argc < 2) {
+                return impl::print_embedded_solutions<DependentName>();
+            }
+        }
+
+        auto options = advent::parse_run_options(argc, argv);
+        if (not options.has_value()) {
+            advent::println("Usage: {} {}", argv[0], advent::run_options::Usage);
+
+            return 1;
+        }
+
+        /* NOTE: Our location is that of our caller, the day's 'main'. */
+        options->puzzle = advent::puzzle_id::from_source_path(location.file_name());
+
+        if (options->trace_path != nullptr) {
+            advent::enable_tracing();
+        }
+
+        /* NOTE: Every part's thread has been joined by the time we export. */
+        advent::scope_guard _ = [&]() {
+            if (options->trace_path != nullptr && not advent::write_trace(options->trace_path) && options->format == advent::output_format::human) {
+                advent::println("Unable to write trace to '{}'!", options->trace_path);
+            }
+        };
+
+        advent::write_record_header(options->format);
+
+        /* Make sure our day can be found when loaded as a library. */
+        static_cast<void>(impl::day_registrar<DependentName>::Registered);
+
+        static constexpr auto NumPartsToSolve = [](auto) {
+            return impl::count_parts_to_solve();
+        }(^^DependentName);
+
+        static constexpr auto HasParser = [](auto) {
+            return impl::input_has_parser();
+        }(^^DependentName);
+
+        /*
+            We can only stream input to whatever first takes it if that
+            would accept lines as they're read, instead of a whole string.
+        */
+        static constexpr auto CanStream = [](auto) {
+            using Lines = const advent::input_stream::lines_view &;
+
+            if constexpr (HasParser) {
+                return advent::input.accepts_input(^^Lines);
+            } else {
+                return NumPartsToSolve > 0 && advent::part_one.accepts_input(^^Lines);
+            }
+        }(^^DependentName);
+
+        if (impl::is_batch(*options)) {
+            if (options->format == advent::output_format::human) {
+                for (const auto option : options->options_ignored_in_batch()) {
+                    advent::println("Ignoring '{}' when solving a batch of inputs.", option);
+                }
+            }
+
+            return impl::solve_batch(impl::make_day_jobs<DependentName>(), *options);
+        }
+
+        /* NOTE: Only now, so that a batch's threads aren't all pinned to the same CPU. */
+        if (options->wants_stable_timings()) {
+            advent::prepare_benchmark_environment(options->pinned_cpu, options->raise_priority, options->format);
+        }
+
+        if (options->stream_input) {
+            if constexpr (CanStream) {
+                return impl::solve_streamed<NumPartsToSolve, HasParser>(*options);
+            } else if (options->format == advent::output_format::human) {
+                advent::println("Unable to solve while reading input, so reading it all first.");
+            }
+        }
+
+        const auto data = advent::puzzle_data(options->input_path);
+        if (not data.has_value()) {
+            advent::println("Unable to read puzzle data!");
+
+            return 1;
+        }
+
+        options->input_bytes = data->size();
+
+        if (options->wants_stable_timings()) {
+            advent::pre_touch(data->view());
+        }
+
+        const auto solve_each_part = [&](const auto &input) -> int {
+            if (options->compare_variants) {
+                return impl::print_variant_comparison<NumPartsToSolve>(input, *options) ? 0 : 1;
+            }
+
+            if (options->solve_parts_concurrently) {
+                return impl::print_solutions_concurrently<NumPartsToSolve>(input, *options) ? 0 : 1;
+            }
+
+            bool all_solved = true;
+
+            template for (constexpr auto Index : std::views::indices(NumPartsToSolve)) {
+                all_solved = advent::print_solution<advent::part<Index>{}>(input, *options) && all_solved;
+            }
+
+            return all_solved ? 0 : 1;
+        };
+
+        if constexpr (HasParser) {
+            /* NOTE: Our model is allocated from this, and so it must outlive our model. */
+            advent::arena parse_arena;
+
+            return solve_each_part(impl::parse_or_load_input(data->view(), *options, parse_arena));
+        } else {
+            return solve_each_part(data->view());
+        }
     }
 }
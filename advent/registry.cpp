@@ -0,0 +1,75 @@
+export module advent:registry;
+
+import std;
+
+namespace advent {
+
+    /* The outcome of solving a single part, with its solution already formatted. */
+    export struct job_result {
+        std::string solution;
+
+        std::chrono::nanoseconds duration;
+    };
+
+    /*
+        Everything needed to solve a day's parts from outside of
+        that day's executable, such as when each day is instead
+        built as a library and loaded by a runner for every day.
+
+        NOTE: The parsed model, if any, is type-erased, and must
+        only be handed back to the same day's 'solve_part' jobs.
+    */
+    export struct day_jobs {
+        using parsed_model = std::shared_ptr<const void>;
+
+        struct parse_result {
+            parsed_model model;
+
+            std::chrono::nanoseconds duration;
+        };
+
+        using parse_function = auto (*)(std::string_view input) -> parse_result;
+        using solve_function = auto (*)(std::string_view input, const void *parsed) -> advent::job_result;
+
+        /* Null when the day has no registered parser. */
+        parse_function parse = nullptr;
+
+        std::vector<solve_function> solve_part;
+
+        constexpr bool has_parser(this const day_jobs &self) {
+            return self.parse != nullptr;
+        }
+
+        constexpr std::size_t num_parts(this const day_jobs &self) {
+            return self.solve_part.size();
+        }
+    };
+
+    /* The name of the symbol by which a day's library exposes its jobs. */
+    export constexpr inline auto day_jobs_symbol = "advent_day_jobs";
+
+    namespace impl {
+
+        auto registered_day_jobs() -> advent::day_jobs & {
+            static constinit auto jobs = advent::day_jobs{};
+
+            return jobs;
+        }
+
+    }
+
+}
+
+extern "C" {
+
+    /*
+        NOTE: This is deliberately visible even when a day
+        is built with hidden visibility, so that it may be
+        found with 'dlsym' once the day has been loaded.
+    */
+    [[gnu::visibility("default")]]
+    auto advent_day_jobs() -> const advent::day_jobs * {
+        return &advent::impl::registered_day_jobs();
+    }
+
+}
@@ -0,0 +1,234 @@
+export module advent:report;
+
+import std;
+
+import :digits;
+import :print;
+import :statistics;
+
+namespace advent {
+
+    /* Which year and day a puzzle belongs to. */
+    export struct puzzle_id {
+        std::size_t year = 0;
+        std::size_t day  = 0;
+
+        /*
+            Our solutions live at '<year>/Day_<day>/main.cpp',
+            so we can tell which puzzle we're solving from that.
+        */
+        static constexpr auto from_source_path(std::string_view path) -> puzzle_id {
+            const auto pop_component = [&]() {
+                const auto separator_pos = path.rfind('/');
+                if (separator_pos == std::string_view::npos) {
+                    return std::exchange(path, std::string_view());
+                }
+
+                const auto component = path.substr(separator_pos + 1);
+                path.remove_suffix(path.size() - separator_pos);
+
+                return component;
+            };
+
+            const auto parse_number = [](const std::string_view str) -> std::size_t {
+                if (str.empty() || not std::ranges::all_of(str, [](const char c) { return advent::is_digit(c, 10); })) {
+                    return 0;
+                }
+
+                return advent::to_integral<std::size_t, 10>(str);
+            };
+
+            static constexpr std::string_view DayPrefix = "Day_";
+
+            /* Discard the file name. */
+            pop_component();
+
+            auto day = pop_component();
+            if (not day.starts_with(DayPrefix)) {
+                return puzzle_id{};
+            }
+
+            day.remove_prefix(DayPrefix.size());
+
+            const auto year = pop_component();
+
+            return puzzle_id{parse_number(year), parse_number(day)};
+        }
+    };
+
+    static_assert(advent::puzzle_id::from_source_path("/src/2024/Day_07/main.cpp").year == 2024);
+    static_assert(advent::puzzle_id::from_source_path("/src/2024/Day_07/main.cpp").day  == 7);
+    static_assert(advent::puzzle_id::from_source_path("main.cpp").day == 0);
+
+    export enum class output_format {
+        human,
+        json_lines,
+        csv,
+    };
+
+    export constexpr auto parse_output_format(const std::string_view name) -> std::optional<advent::output_format> {
+        if (name == "human") {
+            return advent::output_format::human;
+        }
+
+        if (name == "json") {
+            return advent::output_format::json_lines;
+        }
+
+        if (name == "csv") {
+            return advent::output_format::csv;
+        }
+
+        return std::nullopt;
+    }
+
+    /*
+        A machine-readable record of solving one part.
+
+        NOTE: A 'part' of 0 denotes parsing the input.
+    */
+    export struct timing_record {
+        advent::puzzle_id puzzle;
+
+        std::size_t part;
+
+        std::string answer;
+
+        advent::timing_statistics statistics;
+
+        /* Every timed iteration, if kept, from which 'statistics' was computed. */
+        std::span<const advent::timing_statistics::duration> samples = {};
+
+        std::size_t input_bytes;
+
+        /* Which input was solved, when solving more than one. */
+        std::string_view input = {};
+    };
+
+    namespace impl {
+
+        constexpr auto nanoseconds(const advent::timing_statistics::duration duration) -> std::int64_t {
+            return static_cast<std::int64_t>(duration.count());
+        }
+
+        constexpr auto escape_json(const std::string_view str) -> std::string {
+            std::string escaped;
+            escaped.reserve(str.size());
+
+            for (const auto c : str) {
+                switch (c) {
+                    case '"':  escaped += "\\\""; break;
+                    case '\\': escaped += "\\\\"; break;
+                    case '\n': escaped += "\\n";  break;
+                    case '\r': escaped += "\\r";  break;
+                    case '\t': escaped += "\\t";  break;
+
+                    default: {
+                        if (static_cast<unsigned char>(c) < 0x20) {
+                            escaped += std::format("\\u{:04x}", static_cast<unsigned int>(c));
+                        } else {
+                            escaped += c;
+                        }
+                    }
+                }
+            }
+
+            return escaped;
+        }
+
+        constexpr auto json_nanoseconds_array(const std::span<const advent::timing_statistics::duration> samples) -> std::string {
+            return std::format("[{}]", samples | std::views::transform(impl::nanoseconds) | std::views::transform([](const std::int64_t nanoseconds) {
+                return std::format("{}", nanoseconds);
+            }) | std::views::join_with(',') | std::ranges::to<std::string>());
+        }
+
+        constexpr auto escape_csv(const std::string_view str) -> std::string {
+            if (str.find_first_of(",\"\n\r") == std::string_view::npos) {
+                return std::string(str);
+            }
+
+            std::string escaped = "\"";
+            for (const auto c : str) {
+                if (c == '"') {
+                    escaped += '"';
+                }
+
+                escaped += c;
+            }
+
+            escaped += '"';
+
+            return escaped;
+        }
+
+    }
+
+    /* Prints whatever must precede our records, if anything. */
+    export constexpr auto write_record_header(const advent::output_format format) -> void {
+        if (format == advent::output_format::csv) {
+            advent::println("year,day,part,answer,nanoseconds,min_nanoseconds,mean_nanoseconds,stddev_nanoseconds,p99_nanoseconds,iterations,input_bytes,input");
+        }
+    }
+
+    export constexpr auto write_record(const advent::output_format format, const advent::timing_record &record) -> void {
+        const auto &statistics = record.statistics;
+
+        switch (format) {
+            case advent::output_format::json_lines: {
+                advent::println(
+                    R"({{"year":{},"day":{},"part":{},"answer":"{}","nanoseconds":{},"min_nanoseconds":{},"mean_nanoseconds":{},"stddev_nanoseconds":{},"p99_nanoseconds":{},"iterations":{},"input_bytes":{},"input":"{}","samples_nanoseconds":{}}})",
+
+                    record.puzzle.year,
+                    record.puzzle.day,
+                    record.part,
+
+                    impl::escape_json(record.answer),
+
+                    impl::nanoseconds(statistics.median),
+                    impl::nanoseconds(statistics.min),
+                    impl::nanoseconds(statistics.mean),
+                    impl::nanoseconds(statistics.stddev),
+                    impl::nanoseconds(statistics.p99),
+
+                    statistics.num_samples,
+
+                    record.input_bytes,
+
+                    impl::escape_json(record.input),
+
+                    impl::json_nanoseconds_array(record.samples)
+                );
+            } break;
+
+            case advent::output_format::csv: {
+                advent::println(
+                    "{},{},{},{},{},{},{},{},{},{},{},{}",
+
+                    record.puzzle.year,
+                    record.puzzle.day,
+                    record.part,
+
+                    impl::escape_csv(record.answer),
+
+                    impl::nanoseconds(statistics.median),
+                    impl::nanoseconds(statistics.min),
+                    impl::nanoseconds(statistics.mean),
+                    impl::nanoseconds(statistics.stddev),
+                    impl::nanoseconds(statistics.p99),
+
+                    statistics.num_samples,
+
+                    record.input_bytes,
+
+                    impl::escape_csv(record.input)
+                );
+            } break;
+
+            /* Human-readable output is handled by whoever solved the part. */
+            case advent::output_format::human: break;
+
+            default: std::unreachable();
+        }
+    }
+
+}
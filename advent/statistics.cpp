@@ -0,0 +1,159 @@
+export module advent:statistics;
+
+import std;
+
+namespace advent {
+
+    /* Summary statistics over repeated timings of the same code. */
+    export struct timing_statistics {
+        using duration = std::chrono::duration<std::float64_t, std::nano>;
+
+        std::size_t num_samples = 0;
+
+        duration min    = {};
+        duration median = {};
+        duration mean   = {};
+        duration stddev = {};
+        duration p99    = {};
+
+        template<std::ranges::input_range Samples>
+        static constexpr auto from_samples(Samples &&samples) -> timing_statistics {
+            auto sorted = std::vector(std::from_range, std::forward<Samples>(samples) | std::views::transform([](const auto sample) {
+                return std::chrono::duration_cast<duration>(sample);
+            }));
+
+            if (sorted.empty()) {
+                return timing_statistics{};
+            }
+
+            std::ranges::sort(sorted);
+
+            const auto nearest_rank = [&](const std::float64_t percentile) {
+                const auto rank = static_cast<std::size_t>(
+                    std::ceil(percentile * static_cast<std::float64_t>(sorted.size()))
+                );
+
+                return sorted[std::clamp(rank, 1uz, sorted.size()) - 1];
+            };
+
+            const auto median = [&]() {
+                const auto middle = sorted.size() / 2;
+
+                if (sorted.size() % 2 == 0) {
+                    return (sorted[middle - 1] + sorted[middle]) / 2;
+                }
+
+                return sorted[middle];
+            }();
+
+            const auto num_samples = static_cast<std::float64_t>(sorted.size());
+
+            const auto mean = std::ranges::fold_left(sorted, duration{}, std::plus{}) / num_samples;
+
+            const auto variance = std::ranges::fold_left(sorted, std::float64_t{0}, [&](const auto total, const auto sample) {
+                const auto deviation = (sample - mean).count();
+
+                return total + deviation * deviation;
+            }) / num_samples;
+
+            return timing_statistics{
+                .num_samples = sorted.size(),
+
+                .min    = sorted.front(),
+                .median = median,
+                .mean   = mean,
+                .stddev = duration(std::sqrt(variance)),
+                .p99    = nearest_rank(0.99),
+            };
+        }
+    };
+
+    /*
+        The result of a Mann-Whitney U test of whether the
+        samples of 'current' tend to be larger than those of
+        'baseline', such as whether some code has gotten slower.
+    */
+    export struct mann_whitney_result {
+        /* How many (baseline, current) pairs have the current sample larger, with ties counting as half. */
+        std::float64_t u_statistic = 0;
+
+        /* The one-sided probability of seeing a 'u_statistic' at least this large were nothing to have changed. */
+        std::float64_t p_value = 1;
+    };
+
+    /*
+        NOTE: We use the normal approximation, with corrections for ties
+        and for continuity, which is reasonable from around eight samples each.
+    */
+    export template<typename Duration>
+    auto mann_whitney_test(const std::span<const Duration> baseline, const std::span<const Duration> current) -> advent::mann_whitney_result {
+        if (baseline.empty() || current.empty()) {
+            return advent::mann_whitney_result{};
+        }
+
+        struct ranked_sample {
+            Duration sample;
+
+            bool is_current;
+        };
+
+        auto combined = std::vector<ranked_sample>();
+        combined.reserve(baseline.size() + current.size());
+
+        for (const auto sample : baseline) {
+            combined.emplace_back(sample, false);
+        }
+
+        for (const auto sample : current) {
+            combined.emplace_back(sample, true);
+        }
+
+        std::ranges::sort(combined, {}, &ranked_sample::sample);
+
+        const auto num_baseline = static_cast<std::float64_t>(baseline.size());
+        const auto num_current  = static_cast<std::float64_t>(current.size());
+        const auto num_total    = num_baseline + num_current;
+
+        std::float64_t current_rank_sum = 0;
+        std::float64_t tie_correction   = 0;
+
+        /* Tied samples all share the average of the ranks they span. */
+        for (auto start = 0uz; start < combined.size();) {
+            auto end = start + 1;
+            while (end < combined.size() && combined[end].sample == combined[start].sample) {
+                ++end;
+            }
+
+            const auto num_tied     = static_cast<std::float64_t>(end - start);
+            const auto average_rank = static_cast<std::float64_t>(start + end + 1) / 2;
+
+            for (const auto &ranked : std::span(combined).subspan(start, end - start)) {
+                if (ranked.is_current) {
+                    current_rank_sum += average_rank;
+                }
+            }
+
+            tie_correction += num_tied * num_tied * num_tied - num_tied;
+
+            start = end;
+        }
+
+        const auto u_statistic = current_rank_sum - num_current * (num_current + 1) / 2;
+
+        const auto mean     = num_baseline * num_current / 2;
+        const auto variance = num_baseline * num_current / 12 * ((num_total + 1) - tie_correction / (num_total * (num_total - 1)));
+
+        if (variance <= 0) {
+            /* Every sample was the same. */
+            return advent::mann_whitney_result{u_statistic, 1};
+        }
+
+        const auto z_score = (u_statistic - mean - 0.5) / std::sqrt(variance);
+
+        return advent::mann_whitney_result{
+            .u_statistic = u_statistic,
+            .p_value     = std::erfc(z_score / std::numbers::sqrt2) / 2,
+        };
+    }
+
+}
@@ -0,0 +1,232 @@
+export module advent:thread_pool;
+
+import std;
+
+import :benchmark_environment;
+
+namespace advent {
+
+    /*
+        A pool of worker threads which each own a queue of tasks.
+
+        Workers take the most recently queued task from their own
+        queue, and when that runs dry they steal the oldest task
+        from another worker's queue. Tasks submitted from inside
+        a worker are queued to that same worker, so a task which
+        fans out keeps its children close by until they're stolen.
+    */
+    export struct thread_pool {
+        using task = std::move_only_function<void ()>;
+
+        struct worker_queue {
+            std::mutex       _mutex;
+            std::deque<task> _tasks;
+        };
+
+        struct current_worker_info {
+            thread_pool *pool  = nullptr;
+            std::size_t  index = 0;
+        };
+
+        static inline thread_local current_worker_info _current_worker = {};
+
+        /* NOTE: A 'std::deque' so that our queues never move. */
+        std::deque<worker_queue> _queues;
+
+        std::atomic<std::size_t> _num_queued     = 0;
+        std::atomic<std::size_t> _num_unfinished = 0;
+        std::atomic<std::size_t> _next_queue     = 0;
+
+        std::mutex                  _wake_mutex;
+        std::condition_variable_any _wake;
+
+        /* NOTE: Declared last so that our workers are stopped before anything else is destroyed. */
+        std::vector<std::jthread> _workers;
+
+        explicit thread_pool(const std::size_t num_workers = thread_pool::default_num_workers())
+        :
+            _queues(std::max(num_workers, 1uz))
+        {
+            this->_workers.reserve(this->_queues.size());
+
+            for (const auto index : std::views::iota(0uz, this->_queues.size())) {
+                this->_workers.emplace_back([this, index](const std::stop_token stop) {
+                    this->_work(stop, index);
+                });
+            }
+        }
+
+        thread_pool(const thread_pool &) = delete;
+        thread_pool &operator =(const thread_pool &) = delete;
+
+        ~thread_pool() {
+            for (auto &worker : this->_workers) {
+                worker.request_stop();
+            }
+
+            /* NOTE: The workers wait on '_wake' with their stop token, so this is only a courtesy. */
+            this->_wake.notify_all();
+        }
+
+        static auto default_num_workers() -> std::size_t {
+            return std::max(std::thread::hardware_concurrency(), 1u);
+        }
+
+        auto num_workers(this const thread_pool &self) -> std::size_t {
+            return self._workers.size();
+        }
+
+        /* The pool whose worker is the calling thread, if any. */
+        static auto current() -> thread_pool * {
+            return _current_worker.pool;
+        }
+
+        /* A pool for anything which wants to work in parallel without making a pool of its own. */
+        static auto shared() -> thread_pool & {
+            static thread_pool pool;
+
+            return pool;
+        }
+
+        auto submit(this thread_pool &self, task to_run) -> void {
+            const auto queue_index = [&]() {
+                if (_current_worker.pool == &self) {
+                    return _current_worker.index;
+                }
+
+                return self._next_queue.fetch_add(1, std::memory_order_relaxed) % self._queues.size();
+            }();
+
+            self._num_unfinished.fetch_add(1, std::memory_order_relaxed);
+
+            {
+                auto &queue = self._queues[queue_index];
+
+                const auto _ = std::scoped_lock(queue._mutex);
+
+                queue._tasks.push_back(std::move(to_run));
+            }
+
+            {
+                /* NOTE: We lock so that a worker can't miss our wakeup between checking and sleeping. */
+                const auto _ = std::scoped_lock(self._wake_mutex);
+
+                self._num_queued.fetch_add(1, std::memory_order_release);
+            }
+
+            self._wake.notify_one();
+        }
+
+        /*
+            Blocks until every submitted task has finished.
+
+            The calling thread runs tasks itself while it waits,
+            so this is safe to call from inside one of our tasks.
+        */
+        auto wait(this thread_pool &self) -> void {
+            self.help_until([&]() {
+                return self._num_unfinished.load(std::memory_order_acquire) <= 0;
+            });
+        }
+
+        /* Runs queued tasks on the calling thread until 'done' returns true. */
+        template<typename Predicate>
+        requires (std::predicate<Predicate &>)
+        auto help_until(this thread_pool &self, Predicate &&done) -> void {
+            const auto home_index = [&]() {
+                if (_current_worker.pool == &self) {
+                    return _current_worker.index;
+                }
+
+                return 0uz;
+            }();
+
+            while (not std::invoke(done)) {
+                if (self._run_one_task(home_index)) {
+                    continue;
+                }
+
+                /* Nothing to steal, so whatever we wait on is running elsewhere. */
+                auto lock = std::unique_lock(self._wake_mutex);
+
+                self._wake.wait_for(lock, std::chrono::milliseconds(1), [&]() {
+                    return self._num_queued.load(std::memory_order_acquire) > 0 || std::invoke(done);
+                });
+            }
+        }
+
+        auto _take_task(this thread_pool &self, const std::size_t home_index) -> std::optional<task> {
+            /* Try our own queue first, taking the newest task. */
+            {
+                auto &queue = self._queues[home_index];
+
+                const auto _ = std::scoped_lock(queue._mutex);
+
+                if (not queue._tasks.empty()) {
+                    auto taken = std::move(queue._tasks.back());
+                    queue._tasks.pop_back();
+
+                    self._num_queued.fetch_sub(1, std::memory_order_relaxed);
+
+                    return taken;
+                }
+            }
+
+            /* Then steal the oldest task from anyone else. */
+            for (const auto offset : std::views::iota(1uz, self._queues.size())) {
+                auto &queue = self._queues[(home_index + offset) % self._queues.size()];
+
+                const auto _ = std::scoped_lock(queue._mutex);
+
+                if (not queue._tasks.empty()) {
+                    auto taken = std::move(queue._tasks.front());
+                    queue._tasks.pop_front();
+
+                    self._num_queued.fetch_sub(1, std::memory_order_relaxed);
+
+                    return taken;
+                }
+            }
+
+            return std::nullopt;
+        }
+
+        auto _run_one_task(this thread_pool &self, const std::size_t home_index) -> bool {
+            auto taken = self._take_task(home_index);
+            if (not taken.has_value()) {
+                return false;
+            }
+
+            std::invoke(*taken);
+
+            if (self._num_unfinished.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                /* Let anyone waiting on us know that everything is finished. */
+                const auto _ = std::scoped_lock(self._wake_mutex);
+
+                self._wake.notify_all();
+            }
+
+            return true;
+        }
+
+        auto _work(this thread_pool &self, const std::stop_token stop, const std::size_t index) -> void {
+            _current_worker = {&self, index};
+
+            /* NOTE: Our workers shouldn't all crowd onto the one CPU a benchmark was pinned to. */
+            advent::unpin_current_thread();
+
+            while (not stop.stop_requested()) {
+                if (self._run_one_task(index)) {
+                    continue;
+                }
+
+                auto lock = std::unique_lock(self._wake_mutex);
+
+                self._wake.wait(lock, stop, [&]() {
+                    return self._num_queued.load(std::memory_order_acquire) > 0;
+                });
+            }
+        }
+    };
+
+}
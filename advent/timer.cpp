@@ -47,4 +47,71 @@ namespace advent {
         }
     };
 
+    /*
+        Stops the optimizer from discarding a value we
+        computed only so that we could time computing it.
+    */
+    export template<typename T>
+    constexpr void do_not_optimize(T &&value) {
+        if !consteval {
+            asm volatile("" : : "g"(std::addressof(value)) : "memory");
+        }
+    }
+
+    /*
+        A duration which, when formatted, picks whichever of
+        seconds, milliseconds, or microseconds reads best.
+    */
+    export struct scaled_duration {
+        std::chrono::duration<std::float64_t, std::nano> _duration;
+
+        template<typename Rep, typename Period>
+        constexpr explicit(false) scaled_duration(const std::chrono::duration<Rep, Period> duration)
+            : _duration(std::chrono::duration_cast<decltype(_duration)>(duration)) {}
+    };
+
+}
+
+namespace std {
+
+    template<>
+    struct formatter<advent::scaled_duration> {
+        using seconds      = std::chrono::duration<std::float64_t>;
+        using milliseconds = std::chrono::duration<std::float64_t, std::milli>;
+        using microseconds = std::chrono::duration<std::float64_t, std::micro>;
+
+        std::formatter<seconds>      _seconds;
+        std::formatter<milliseconds> _milliseconds;
+        std::formatter<microseconds> _microseconds;
+
+        constexpr auto parse(this formatter &self, std::format_parse_context &ctx) {
+            /*
+                NOTE: Each formatter parses the same specification, and so
+                would each take another argument for a dynamic width or
+                precision, which we reject rather than format wrongly.
+            */
+            const auto spec = std::string_view(ctx.begin(), ctx.end());
+            if (spec.substr(0, spec.find('}')).contains('{')) {
+                throw std::format_error("'advent::scaled_duration' does not support a dynamic width or precision");
+            }
+
+            self._seconds.parse(ctx);
+            self._milliseconds.parse(ctx);
+
+            return self._microseconds.parse(ctx);
+        }
+
+        auto format(this const formatter &self, const advent::scaled_duration duration, auto &ctx) {
+            if (duration._duration >= std::chrono::seconds(1)) {
+                return self._seconds.format(std::chrono::duration_cast<seconds>(duration._duration), ctx);
+            }
+
+            if (duration._duration >= std::chrono::milliseconds(1)) {
+                return self._milliseconds.format(std::chrono::duration_cast<milliseconds>(duration._duration), ctx);
+            }
+
+            return self._microseconds.format(std::chrono::duration_cast<microseconds>(duration._duration), ctx);
+        }
+    };
+
 }
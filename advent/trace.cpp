@@ -0,0 +1,193 @@
+export module advent:trace;
+
+import std;
+
+import :report;
+import :scope_guard;
+
+namespace advent {
+
+    namespace impl {
+
+        struct trace_event {
+            std::string_view name;
+
+            std::chrono::steady_clock::duration start;
+            std::chrono::steady_clock::duration duration;
+        };
+
+        /*
+            The most recent events recorded by a single thread.
+
+            Once full, each new event overwrites the oldest one,
+            so a hot scope can never make us grow without bound.
+        */
+        struct trace_buffer {
+            static constexpr std::size_t Capacity = 1 << 16;
+
+            std::size_t thread_index;
+
+            std::vector<impl::trace_event> events;
+
+            /* How many events were ever recorded, including any since overwritten. */
+            std::size_t num_recorded = 0;
+
+            auto record(this trace_buffer &self, const impl::trace_event &event) -> void {
+                if (self.events.size() < Capacity) {
+                    self.events.push_back(event);
+                } else {
+                    self.events[self.num_recorded % Capacity] = event;
+                }
+
+                self.num_recorded += 1;
+            }
+
+            /* Calls 'consumer' with each event, oldest first. */
+            template<typename Consumer>
+            auto for_each_event(this const trace_buffer &self, Consumer &&consumer) -> void {
+                const auto oldest = (self.events.size() < Capacity) ? 0uz : (self.num_recorded % Capacity);
+
+                for (const auto offset : std::views::iota(0uz, self.events.size())) {
+                    std::invoke(consumer, self.events[(oldest + offset) % self.events.size()]);
+                }
+            }
+        };
+
+        struct trace_registry {
+            std::atomic<bool> enabled = false;
+
+            std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+
+            std::mutex mutex;
+
+            /* NOTE: Shared so that a thread's events outlive the thread. */
+            std::vector<std::shared_ptr<impl::trace_buffer>> buffers;
+        };
+
+        auto global_trace_registry() -> impl::trace_registry & {
+            static auto registry = impl::trace_registry{};
+
+            return registry;
+        }
+
+        auto current_trace_buffer() -> impl::trace_buffer & {
+            static thread_local const auto buffer = []() {
+                auto &registry = impl::global_trace_registry();
+
+                const auto _ = std::scoped_lock(registry.mutex);
+
+                auto buffer = std::make_shared<impl::trace_buffer>(registry.buffers.size());
+                registry.buffers.push_back(buffer);
+
+                return buffer;
+            }();
+
+            return *buffer;
+        }
+
+    }
+
+    /* Tracing is off until enabled, leaving each 'trace_scope' with only a flag to check. */
+    export auto enable_tracing() -> void {
+        impl::global_trace_registry().enabled.store(true, std::memory_order_relaxed);
+    }
+
+    /*
+        Records how long a named region of code took, for
+        viewing later in a trace viewer alongside every other
+        region, including those nested within it.
+
+        'name' must outlive the trace, which a string literal does.
+
+        These compile away to nothing during constant evaluation.
+    */
+    export struct trace_scope {
+        std::string_view _name;
+
+        std::chrono::steady_clock::time_point _start = {};
+
+        bool _active = false;
+
+        constexpr explicit trace_scope(const std::string_view name) : _name(name) {
+            if !consteval {
+                if (impl::global_trace_registry().enabled.load(std::memory_order_relaxed)) {
+                    this->_active = true;
+                    this->_start  = std::chrono::steady_clock::now();
+                }
+            }
+        }
+
+        trace_scope(const trace_scope &) = delete;
+        trace_scope &operator =(const trace_scope &) = delete;
+
+        trace_scope(trace_scope &&) = delete;
+        trace_scope &operator =(trace_scope &&) = delete;
+
+        constexpr ~trace_scope() {
+            if !consteval {
+                if (not this->_active) {
+                    return;
+                }
+
+                const auto end = std::chrono::steady_clock::now();
+
+                impl::current_trace_buffer().record(impl::trace_event{
+                    .name     = this->_name,
+                    .start    = this->_start - impl::global_trace_registry().epoch,
+                    .duration = end - this->_start,
+                });
+            }
+        }
+    };
+
+    /*
+        Writes every recorded event as Chrome 'trace_event' JSON,
+        which may be opened with e.g. 'chrome://tracing' or Perfetto.
+
+        NOTE: This should only be called once every traced thread is done.
+    */
+    export auto write_trace(const char *path) -> bool {
+        const auto fp = std::fopen(path, "w");
+        if (fp == nullptr) {
+            return false;
+        }
+
+        advent::scope_guard _ = [&]() {
+            std::fclose(fp);
+        };
+
+        using microseconds = std::chrono::duration<std::float64_t, std::micro>;
+
+        auto &registry = impl::global_trace_registry();
+
+        const auto lock = std::scoped_lock(registry.mutex);
+
+        std::print(fp, R"({{"displayTimeUnit":"ns","traceEvents":[)");
+
+        bool first = true;
+        for (const auto &buffer : registry.buffers) {
+            buffer->for_each_event([&](const impl::trace_event &event) {
+                std::print(
+                    fp,
+
+                    R"({}{{"name":"{}","ph":"X","pid":0,"tid":{},"ts":{:.3f},"dur":{:.3f}}})",
+
+                    first ? "" : ",",
+
+                    impl::escape_json(event.name),
+                    buffer->thread_index,
+
+                    std::chrono::duration_cast<microseconds>(event.start).count(),
+                    std::chrono::duration_cast<microseconds>(event.duration).count()
+                );
+
+                first = false;
+            });
+        }
+
+        std::print(fp, "]}}\n");
+
+        return true;
+    }
+
+}
@@ -0,0 +1,137 @@
+module;
+
+/* NOTE: Needed for 'stdout'. */
+#include <cstdio>
+
+export module advent:watchdog;
+
+import std;
+
+import :print;
+import :report;
+import :timer;
+import :cancellation;
+import :benchmark_environment;
+
+namespace advent {
+
+    /*
+        Keeps an eye on a part as it's solved, and once the part has
+        run over its budget, reports how far it got and asks it to
+        give up through its 'advent::cancellation_source'.
+
+        Should the part still not have given up after a grace period,
+        we exit outright rather than hang whoever is waiting on us.
+
+        NOTE: We only report in 'output_format::human', since anything
+        else is parsed as records, which our reports would corrupt.
+    */
+    export struct watchdog {
+        static constexpr auto GracePeriod = std::chrono::seconds(1);
+
+        /* The same as that of the 'timeout' utility. */
+        static constexpr int TimeoutExitCode = 124;
+
+        std::string_view _name;
+
+        std::chrono::steady_clock::duration _budget;
+
+        advent::cancellation_source &_cancellation;
+
+        advent::output_format _format;
+
+        std::atomic<std::size_t> _completed_iterations = 0;
+        std::atomic<bool>        _timed_out            = false;
+
+        std::mutex                  _mutex;
+        std::condition_variable_any _stopped;
+
+        /* NOTE: Declared last so that it's stopped before anything else is destroyed. */
+        std::jthread _thread;
+
+        template<typename Rep, typename Period>
+        watchdog(const std::string_view name, const std::chrono::duration<Rep, Period> budget, advent::cancellation_source &cancellation, const advent::output_format format)
+        :
+            _name(name),
+            _budget(std::chrono::duration_cast<std::chrono::steady_clock::duration>(budget)),
+            _cancellation(cancellation),
+            _format(format)
+        {
+            this->_thread = std::jthread([this](const std::stop_token stop) {
+                this->_watch(stop);
+            });
+        }
+
+        watchdog(const watchdog &) = delete;
+        watchdog &operator =(const watchdog &) = delete;
+
+        /* Waits out 'duration', returning whether we were stopped before then. */
+        auto _wait_for_stop(this watchdog &self, const std::stop_token &stop, const std::chrono::steady_clock::duration duration) -> bool {
+            auto lock = std::unique_lock(self._mutex);
+
+            return self._stopped.wait_for(lock, stop, duration, [&]() {
+                return stop.stop_requested();
+            });
+        }
+
+        auto _watch(this watchdog &self, const std::stop_token stop) -> void {
+            /* NOTE: So that we don't compete for the CPU the part being timed may be pinned to. */
+            advent::unpin_current_thread();
+
+            const auto start = std::chrono::steady_clock::now();
+
+            if (self._wait_for_stop(stop, self._budget)) {
+                return;
+            }
+
+            self._timed_out.store(true, std::memory_order_relaxed);
+            self._cancellation.request_cancellation();
+
+            const auto report = (self._format == advent::output_format::human);
+
+            if (report) {
+                advent::println(
+                    "{} ran over its budget of {:.3} after {:.3} and {} completed iterations, cancelling...",
+
+                    self._name,
+
+                    advent::scaled_duration(self._budget),
+                    advent::scaled_duration(std::chrono::steady_clock::now() - start),
+
+                    self._completed_iterations.load(std::memory_order_relaxed)
+                );
+
+                advent::flush_output();
+            }
+
+            if (self._wait_for_stop(stop, GracePeriod)) {
+                return;
+            }
+
+            if (report) {
+                advent::println("{} did not stop when cancelled, exiting.", self._name);
+            }
+
+            /* NOTE: Nothing will be flushed for us when exiting like this. */
+            advent::flush_output();
+            std::fflush(stdout);
+
+            std::_Exit(TimeoutExitCode);
+        }
+
+        auto complete_iteration(this watchdog &self) -> void {
+            self._completed_iterations.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        /* Stops watching, returning whether the part ran over its budget. */
+        auto stop(this watchdog &self) -> bool {
+            if (self._thread.joinable()) {
+                self._thread.request_stop();
+                self._thread.join();
+            }
+
+            return self._timed_out.load(std::memory_order_relaxed);
+        }
+    };
+
+}
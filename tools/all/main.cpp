@@ -0,0 +1,329 @@
+/*
+    Runs every day's parts in a single process.
+
+    Each day is built as a library which registers its jobs when
+    loaded. Loading them as separate libraries keeps each day's
+    registrations, which all share the same names, apart from one
+    another. Every (year, day, part) job then runs on one shared
+    work-stealing thread pool.
+
+    Usage: advent_all <inputs directory> [--threads <count>] [--modules <directory>] [--format human|json|csv]
+
+    The input for a day is read from '<inputs directory>/<year>_<day>.txt',
+    e.g. '2024_Day_07.txt', and days without an input are skipped.
+*/
+
+/* NOTE: Needed for 'dlopen' and friends. */
+#include <dlfcn.h>
+
+import std;
+import advent;
+
+struct LoadedDay {
+    std::string name;
+
+    std::size_t year;
+    std::size_t day;
+
+    const advent::day_jobs *jobs;
+
+    advent::puzzle_input input;
+
+    advent::day_jobs::parsed_model parsed = nullptr;
+    std::chrono::nanoseconds       parse_duration = {};
+
+    std::vector<advent::job_result> results;
+
+    static constexpr auto ParseName(const std::string_view name) -> std::optional<std::pair<std::size_t, std::size_t>> {
+        /* Names look like '2024_Day_07'. */
+        static constexpr std::string_view DaySeparator = "_Day_";
+
+        const auto separator_pos = name.find(DaySeparator);
+        if (separator_pos == std::string_view::npos) {
+            return std::nullopt;
+        }
+
+        const auto year = name.substr(0, separator_pos);
+        const auto day  = name.substr(separator_pos + DaySeparator.size());
+
+        const auto all_digits = [](const std::string_view str) {
+            return not str.empty() && std::ranges::all_of(str, [](const char c) {
+                return advent::is_digit(c, 10);
+            });
+        };
+
+        if (not all_digits(year) || not all_digits(day)) {
+            return std::nullopt;
+        }
+
+        return std::pair(advent::to_integral<std::size_t, 10>(year), advent::to_integral<std::size_t, 10>(day));
+    }
+};
+
+struct RunnerOptions {
+    std::filesystem::path inputs;
+    std::filesystem::path modules = ADVENT_MODULE_DIRECTORY;
+
+    std::size_t num_threads = advent::thread_pool::default_num_workers();
+
+    advent::output_format format = advent::output_format::human;
+
+    static auto Parse(const std::span<const char * const> args) -> std::optional<RunnerOptions> {
+        RunnerOptions options;
+
+        bool have_inputs = false;
+        for (auto it = args.begin() + 1; it < args.end(); ++it) {
+            const auto arg = std::string_view(*it);
+
+            const auto next = [&]() -> std::optional<std::string_view> {
+                ++it;
+                if (it >= args.end()) {
+                    return std::nullopt;
+                }
+
+                return *it;
+            };
+
+            if (arg == "--threads") {
+                const auto count = next();
+                if (not count.has_value()) {
+                    return std::nullopt;
+                }
+
+                std::size_t num_threads;
+                const auto [end, error] = std::from_chars(count->data(), count->data() + count->size(), num_threads);
+                if (error != std::errc() || end != count->data() + count->size() || num_threads <= 0) {
+                    return std::nullopt;
+                }
+
+                options.num_threads = num_threads;
+            } else if (arg == "--modules") {
+                const auto directory = next();
+                if (not directory.has_value()) {
+                    return std::nullopt;
+                }
+
+                options.modules = *directory;
+            } else if (arg == "--format") {
+                const auto name = next();
+                if (not name.has_value()) {
+                    return std::nullopt;
+                }
+
+                const auto format = advent::parse_output_format(*name);
+                if (not format.has_value()) {
+                    return std::nullopt;
+                }
+
+                options.format = *format;
+            } else if (not have_inputs) {
+                options.inputs = arg;
+
+                have_inputs = true;
+            } else {
+                return std::nullopt;
+            }
+        }
+
+        if (not have_inputs) {
+            return std::nullopt;
+        }
+
+        return options;
+    }
+};
+
+auto load_days(const RunnerOptions &options) -> std::vector<LoadedDay> {
+    std::vector<LoadedDay> days;
+
+    for (const auto &entry : std::filesystem::directory_iterator(options.modules)) {
+        if (entry.path().extension() != ".so") {
+            continue;
+        }
+
+        auto name = entry.path().stem().string();
+
+        const auto year_and_day = LoadedDay::ParseName(name);
+        if (not year_and_day.has_value()) {
+            continue;
+        }
+
+        auto input = advent::puzzle_data((options.inputs / (name + ".txt")).c_str());
+        if (not input.has_value()) {
+            continue;
+        }
+
+        /*
+            NOTE: 'RTLD_LOCAL' keeps each day's symbols to itself.
+
+            We also never close these, since their jobs' results
+            may hold on to memory allocated by their code.
+        */
+        const auto handle = dlopen(entry.path().c_str(), RTLD_NOW | RTLD_LOCAL);
+        if (handle == nullptr) {
+            advent::println("Unable to load '{}': {}", name, dlerror());
+
+            continue;
+        }
+
+        const auto get_jobs = reinterpret_cast<const advent::day_jobs *(*)()>(
+            dlsym(handle, advent::day_jobs_symbol)
+        );
+
+        if (get_jobs == nullptr) {
+            advent::println("Unable to find the jobs for '{}'", name);
+
+            continue;
+        }
+
+        const auto [year, day] = *year_and_day;
+
+        days.push_back(LoadedDay{
+            .name  = std::move(name),
+            .year  = year,
+            .day   = day,
+            .jobs  = get_jobs(),
+            .input = std::move(*input),
+        });
+    }
+
+    std::ranges::sort(days, {}, [](const LoadedDay &day) {
+        return std::pair(day.year, day.day);
+    });
+
+    return days;
+}
+
+auto schedule_day(advent::thread_pool &pool, LoadedDay &day) -> void {
+    day.results.resize(day.jobs->num_parts());
+
+    const auto submit_parts = [&pool, &day]() {
+        for (const auto [index, solve_part] : day.jobs->solve_part | std::views::enumerate) {
+            pool.submit([&day, index, solve_part]() {
+                day.results[static_cast<std::size_t>(index)] = solve_part(day.input.view(), day.parsed.get());
+            });
+        }
+    };
+
+    if (not day.jobs->has_parser()) {
+        submit_parts();
+
+        return;
+    }
+
+    /* Parse first, and then fan out to each part from the parsing thread. */
+    pool.submit([&day, submit_parts]() {
+        auto [model, duration] = day.jobs->parse(day.input.view());
+
+        day.parsed         = std::move(model);
+        day.parse_duration = duration;
+
+        submit_parts();
+    });
+}
+
+auto print_table(const std::span<const LoadedDay> days, const std::chrono::nanoseconds wall_duration) -> void {
+    auto total_cpu     = std::chrono::nanoseconds{};
+    auto critical_path = std::chrono::nanoseconds{};
+
+    advent::println("Year\tDay\tPart\tTime\t\tSolution");
+
+    for (const auto &day : days) {
+        if (day.jobs->has_parser()) {
+            advent::println("{}\t{}\tparse\t{:.3}", day.year, day.day, advent::scaled_duration(day.parse_duration));
+        }
+
+        auto longest_part = std::chrono::nanoseconds{};
+        for (const auto [index, result] : day.results | std::views::enumerate) {
+            advent::println(
+                "{}\t{}\t{}\t{:.3}\t{}",
+
+                day.year, day.day, index + 1,
+
+                advent::scaled_duration(result.duration),
+
+                result.solution
+            );
+
+            total_cpu   += result.duration;
+            longest_part = std::max(longest_part, result.duration);
+        }
+
+        total_cpu += day.parse_duration;
+
+        /* A day's parts may only begin once it has been parsed. */
+        critical_path = std::max(critical_path, day.parse_duration + longest_part);
+    }
+
+    advent::println();
+    advent::println("Total CPU time:\t\t{:.3}", advent::scaled_duration(total_cpu));
+    advent::println("Critical path time:\t{:.3}", advent::scaled_duration(critical_path));
+    advent::println("Wall time:\t\t{:.3}", advent::scaled_duration(wall_duration));
+}
+
+auto write_records(const advent::output_format format, const std::span<const LoadedDay> days) -> void {
+    const auto write_one = [&](const LoadedDay &day, const std::size_t part, std::string answer, const std::chrono::nanoseconds duration) {
+        advent::write_record(format, advent::timing_record{
+            .puzzle = {day.year, day.day},
+            .part   = part,
+            .answer = std::move(answer),
+
+            /* NOTE: We only ever solve each part once. */
+            .statistics = advent::timing_statistics::from_samples(std::array{duration}),
+
+            .input_bytes = day.input.size(),
+        });
+    };
+
+    advent::write_record_header(format);
+
+    for (const auto &day : days) {
+        if (day.jobs->has_parser()) {
+            write_one(day, 0, std::string(), day.parse_duration);
+        }
+
+        for (const auto [index, result] : day.results | std::views::enumerate) {
+            write_one(day, static_cast<std::size_t>(index) + 1, result.solution, result.duration);
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    const auto options = RunnerOptions::Parse(std::span<const char * const>(argv, static_cast<std::size_t>(argc)));
+    if (not options.has_value()) {
+        advent::println("Usage: {} <inputs directory> [--threads <count>] [--modules <directory>] [--format human|json|csv]", argv[0]);
+
+        return 1;
+    }
+
+    auto days = load_days(*options);
+    if (days.empty()) {
+        advent::println("No days could be loaded!");
+
+        return 1;
+    }
+
+    advent::timer timer;
+
+    {
+        auto pool = advent::thread_pool(options->num_threads);
+
+        auto _ = timer.measure_scope();
+
+        for (auto &day : days) {
+            schedule_day(pool, day);
+        }
+
+        pool.wait();
+    }
+
+    if (options->format != advent::output_format::human) {
+        write_records(options->format, days);
+
+        return 0;
+    }
+
+    print_table(days, timer.last_measured_duration());
+
+    return 0;
+}
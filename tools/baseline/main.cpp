@@ -0,0 +1,324 @@
+/*
+    Records how long each day's parts take into a baseline,
+    and later compares against that baseline, so that any
+    part which has gotten significantly slower stands out.
+
+    Usage: advent_baseline record|compare <baseline> <inputs directory> <day>... [--bench <iterations>] [--alpha <p-value>] [--threshold <fraction>]
+
+    For example:
+
+        advent_baseline record  baseline.txt inputs ./2024_Day_07 ./2024_Day_11
+        advent_baseline compare baseline.txt inputs ./2024_Day_07 ./2024_Day_11
+
+    As with 'advent_all', the input for a day is read from
+    '<inputs directory>/<year>_<day>.txt', e.g. '2024_Day_07.txt'.
+
+    Each day is benchmarked, and every one of its timed iterations
+    is kept. When comparing, a part has regressed if a Mann-Whitney
+    U test finds it slower with a p-value below 'alpha', and its
+    median time has grown by more than 'threshold', so that changes
+    too small to care about aren't reported however certain they are.
+*/
+
+import std;
+import advent;
+
+enum class Mode {
+    Record,
+    Compare,
+};
+
+struct BaselineOptions {
+    Mode mode = Mode::Record;
+
+    std::filesystem::path baseline;
+    std::filesystem::path inputs;
+
+    std::vector<std::string> days;
+
+    std::size_t bench_iterations = 30;
+
+    std::float64_t alpha     = 0.01;
+    std::float64_t threshold = 0.05;
+
+    static auto Parse(const std::span<const char * const> args) -> std::optional<BaselineOptions> {
+        BaselineOptions options;
+
+        std::vector<std::string_view> positional;
+        for (auto it = args.begin() + 1; it < args.end(); ++it) {
+            const auto arg = std::string_view(*it);
+
+            const auto parse_next = [&](auto &value) {
+                ++it;
+                if (it >= args.end()) {
+                    return false;
+                }
+
+                const auto str = std::string_view(*it);
+
+                const auto [end, error] = std::from_chars(str.data(), str.data() + str.size(), value);
+
+                return error == std::errc() && end == str.data() + str.size();
+            };
+
+            if (arg == "--bench") {
+                if (not parse_next(options.bench_iterations) || options.bench_iterations <= 0) {
+                    return std::nullopt;
+                }
+            } else if (arg == "--alpha") {
+                if (not parse_next(options.alpha) || options.alpha <= 0 || options.alpha >= 1) {
+                    return std::nullopt;
+                }
+            } else if (arg == "--threshold") {
+                if (not parse_next(options.threshold) || options.threshold < 0) {
+                    return std::nullopt;
+                }
+            } else {
+                positional.push_back(arg);
+            }
+        }
+
+        if (positional.size() < 4) {
+            return std::nullopt;
+        }
+
+        if (positional[0] == "record") {
+            options.mode = Mode::Record;
+        } else if (positional[0] == "compare") {
+            options.mode = Mode::Compare;
+        } else {
+            return std::nullopt;
+        }
+
+        options.baseline = positional[1];
+        options.inputs   = positional[2];
+
+        options.days = std::vector<std::string>(std::from_range, positional | std::views::drop(3));
+
+        return options;
+    }
+};
+
+using Duration = advent::timing_statistics::duration;
+
+/* A (year, day, part), where a part of 0 denotes parsing. */
+using PartKey = std::tuple<std::size_t, std::size_t, std::size_t>;
+
+using Baseline = std::map<PartKey, std::vector<Duration>>;
+
+static constexpr std::string_view BaselineHeader = "# advent baseline 1";
+
+/*
+    Our baseline is plain text, with a line for each part:
+
+        <year> <day> <part> <nanoseconds>...
+
+    listing the duration of each of its timed iterations.
+*/
+auto read_baseline(const std::filesystem::path &path) -> std::optional<Baseline> {
+    auto file = std::ifstream(path);
+    if (not file) {
+        return std::nullopt;
+    }
+
+    std::string line;
+    if (not std::getline(file, line) || line != BaselineHeader) {
+        return std::nullopt;
+    }
+
+    Baseline baseline;
+
+    while (std::getline(file, line)) {
+        if (line.empty()) {
+            continue;
+        }
+
+        auto stream = std::istringstream(line);
+
+        std::size_t year, day, part;
+        if (not (stream >> year >> day >> part)) {
+            return std::nullopt;
+        }
+
+        auto &samples = baseline[PartKey(year, day, part)];
+
+        std::int64_t nanoseconds;
+        while (stream >> nanoseconds) {
+            samples.push_back(std::chrono::nanoseconds(nanoseconds));
+        }
+    }
+
+    return baseline;
+}
+
+auto write_baseline(const std::filesystem::path &path, const Baseline &baseline) -> bool {
+    auto file = std::ofstream(path);
+    if (not file) {
+        return false;
+    }
+
+    std::println(file, "{}", BaselineHeader);
+
+    for (const auto &[key, samples] : baseline) {
+        const auto [year, day, part] = key;
+
+        std::print(file, "{} {} {}", year, day, part);
+
+        for (const auto sample : samples) {
+            std::print(file, " {}", static_cast<std::int64_t>(sample.count()));
+        }
+
+        std::println(file);
+    }
+
+    return static_cast<bool>(file);
+}
+
+/* Benchmarks 'day' on its input, returning the samples of each of its parts. */
+auto benchmark_day(const BaselineOptions &options, const std::string &day) -> std::optional<Baseline> {
+    const auto input_path = options.inputs / (std::filesystem::path(day).filename().string() + ".txt");
+
+    const auto output = advent::run_command(std::format(
+        "{} {} --format json --bench {}",
+
+        advent::shell_quoted(day), advent::shell_quoted(input_path.string()), options.bench_iterations
+    ));
+
+    if (not output.has_value()) {
+        return std::nullopt;
+    }
+
+    static const auto RecordPattern  = std::regex(R"re("year":(\d+),"day":(\d+),"part":(\d+),)re");
+    static const auto SamplesPattern = std::regex(R"re("samples_nanoseconds":\[([\d,]*)\])re");
+
+    Baseline samples_by_part;
+
+    for (const auto line : *output | std::views::split('\n')) {
+        const auto record = std::string(std::from_range, line);
+
+        std::smatch key_match;
+        std::smatch samples_match;
+        if (not std::regex_search(record, key_match, RecordPattern) || not std::regex_search(record, samples_match, SamplesPattern)) {
+            continue;
+        }
+
+        const auto to_size = [](const auto &match) {
+            return advent::to_integral<std::size_t>(std::string_view(match.first, match.second));
+        };
+
+        auto &samples = samples_by_part[PartKey(to_size(key_match[1]), to_size(key_match[2]), to_size(key_match[3]))];
+
+        const auto samples_repr = std::string_view(samples_match[1].first, samples_match[1].second);
+        if (samples_repr.empty()) {
+            continue;
+        }
+
+        advent::split_for_each(samples_repr, ',', [&](const std::string_view sample) {
+            samples.push_back(std::chrono::nanoseconds(advent::to_integral<std::int64_t>(sample)));
+        });
+    }
+
+    return samples_by_part;
+}
+
+auto part_name(const std::size_t part) -> std::string {
+    if (part == 0) {
+        return "parse";
+    }
+
+    return std::format("{}", part);
+}
+
+/* Returns whether any part has regressed. */
+auto compare_against_baseline(const BaselineOptions &options, const Baseline &baseline, const Baseline &current) -> bool {
+    bool any_regressed = false;
+
+    advent::println("Year\tDay\tPart\tBaseline\tCurrent\t\tChange\t\tp-value");
+
+    for (const auto &[key, samples] : current) {
+        const auto [year, day, part] = key;
+
+        const auto baseline_it = baseline.find(key);
+        if (baseline_it == baseline.end() || baseline_it->second.empty()) {
+            advent::println("{}\t{}\t{}\tno baseline", year, day, part_name(part));
+
+            continue;
+        }
+
+        const auto &baseline_samples = baseline_it->second;
+
+        const auto baseline_median = advent::timing_statistics::from_samples(baseline_samples).median;
+        const auto current_median  = advent::timing_statistics::from_samples(samples).median;
+
+        const auto change = (current_median - baseline_median) / std::max(baseline_median, Duration(1));
+
+        const auto test = advent::mann_whitney_test<Duration>(baseline_samples, samples);
+
+        const auto regressed = test.p_value < options.alpha && change > options.threshold;
+        any_regressed = any_regressed || regressed;
+
+        advent::println(
+            "{}\t{}\t{}\t{:.3}\t\t{:.3}\t\t{:+.1f}%\t\t{:.4f}{}",
+
+            year, day, part_name(part),
+
+            advent::scaled_duration(baseline_median),
+            advent::scaled_duration(current_median),
+
+            change * 100, test.p_value,
+
+            regressed ? "\t<-- regressed" : ""
+        );
+    }
+
+    return any_regressed;
+}
+
+int main(int argc, char **argv) {
+    const auto options = BaselineOptions::Parse(std::span<const char * const>(argv, static_cast<std::size_t>(argc)));
+    if (not options.has_value()) {
+        advent::println("Usage: {} record|compare <baseline> <inputs directory> <day>... [--bench <iterations>] [--alpha <p-value>] [--threshold <fraction>]", argv[0]);
+
+        return 1;
+    }
+
+    Baseline current;
+    for (const auto &day : options->days) {
+        auto day_samples = benchmark_day(*options, day);
+        if (not day_samples.has_value()) {
+            advent::println("Unable to benchmark '{}'!", day);
+
+            return 1;
+        }
+
+        current.merge(std::move(*day_samples));
+    }
+
+    if (options->mode == Mode::Record) {
+        /* NOTE: Parts we didn't just run keep whatever they had before. */
+        auto baseline = read_baseline(options->baseline).value_or(Baseline());
+
+        for (auto &[key, samples] : current) {
+            baseline.insert_or_assign(key, std::move(samples));
+        }
+
+        if (not write_baseline(options->baseline, baseline)) {
+            advent::println("Unable to write baseline to '{}'!", options->baseline.string());
+
+            return 1;
+        }
+
+        advent::println("Recorded {} parts to '{}'", current.size(), options->baseline.string());
+
+        return 0;
+    }
+
+    const auto baseline = read_baseline(options->baseline);
+    if (not baseline.has_value()) {
+        advent::println("Unable to read baseline from '{}'!", options->baseline.string());
+
+        return 1;
+    }
+
+    return compare_against_baseline(*options, *baseline, current) ? 1 : 0;
+}
@@ -0,0 +1,218 @@
+/*
+    Times a day over inputs of increasing scale, and fits
+    how its time grows with that scale, so that unexpectedly
+    quadratic (or worse) parts stand out on their own.
+
+    Usage: advent_sweep <day> <generator> <scale>... [--seed <seed>] [--bench <iterations>] [--warn-above <exponent>]
+
+    For example:
+
+        advent_sweep ./2025_Day_08 ./2025_Day_08_generate 250 500 1000 2000
+
+    For each scale, the generator's output is written to a temporary
+    file and the day is run on it, reporting its timings as JSON.
+*/
+
+import std;
+import advent;
+
+struct SweepOptions {
+    std::string day;
+    std::string generator;
+
+    std::vector<std::size_t> scales;
+
+    std::uint64_t seed             = 0;
+    std::size_t   bench_iterations = 5;
+
+    /* Parts which grow faster than this are called out. */
+    std::float64_t warn_above = 1.5;
+
+    static auto Parse(const std::span<const char * const> args) -> std::optional<SweepOptions> {
+        SweepOptions options;
+
+        std::vector<std::string_view> positional;
+        for (auto it = args.begin() + 1; it < args.end(); ++it) {
+            const auto arg = std::string_view(*it);
+
+            const auto next = [&]() -> std::optional<std::string_view> {
+                ++it;
+                if (it >= args.end()) {
+                    return std::nullopt;
+                }
+
+                return *it;
+            };
+
+            const auto parse_next = [&](auto &value) {
+                const auto str = next();
+                if (not str.has_value()) {
+                    return false;
+                }
+
+                const auto [end, error] = std::from_chars(str->data(), str->data() + str->size(), value);
+
+                return error == std::errc() && end == str->data() + str->size();
+            };
+
+            if (arg == "--seed") {
+                if (not parse_next(options.seed)) {
+                    return std::nullopt;
+                }
+            } else if (arg == "--bench") {
+                if (not parse_next(options.bench_iterations) || options.bench_iterations <= 0) {
+                    return std::nullopt;
+                }
+            } else if (arg == "--warn-above") {
+                if (not parse_next(options.warn_above)) {
+                    return std::nullopt;
+                }
+            } else {
+                positional.push_back(arg);
+            }
+        }
+
+        /* We need at least two scales to fit anything. */
+        if (positional.size() < 4) {
+            return std::nullopt;
+        }
+
+        options.day       = positional[0];
+        options.generator = positional[1];
+
+        for (const auto scale : positional | std::views::drop(2)) {
+            std::size_t value;
+
+            const auto [end, error] = std::from_chars(scale.data(), scale.data() + scale.size(), value);
+            if (error != std::errc() || end != scale.data() + scale.size() || value <= 0) {
+                return std::nullopt;
+            }
+
+            options.scales.push_back(value);
+        }
+
+        return options;
+    }
+};
+
+struct Sample {
+    std::size_t scale;
+
+    std::chrono::nanoseconds duration;
+};
+
+/*
+    Fits 'time = c * scale^k' by least squares over the
+    logarithms of each, and returns the exponent 'k'.
+*/
+auto fit_exponent(const std::span<const Sample> samples) -> std::float64_t {
+    const auto num_samples = static_cast<std::float64_t>(samples.size());
+
+    std::float64_t sum_x  = 0;
+    std::float64_t sum_y  = 0;
+    std::float64_t sum_xx = 0;
+    std::float64_t sum_xy = 0;
+
+    for (const auto &sample : samples) {
+        const auto x = std::log(static_cast<std::float64_t>(sample.scale));
+        const auto y = std::log(std::max(static_cast<std::float64_t>(sample.duration.count()), 1.0));
+
+        sum_x  += x;
+        sum_y  += y;
+        sum_xx += x * x;
+        sum_xy += x * y;
+    }
+
+    const auto denominator = num_samples * sum_xx - sum_x * sum_x;
+    if (denominator == 0) {
+        return 0;
+    }
+
+    return (num_samples * sum_xy - sum_x * sum_y) / denominator;
+}
+
+int main(int argc, char **argv) {
+    const auto options = SweepOptions::Parse(std::span<const char * const>(argv, static_cast<std::size_t>(argc)));
+    if (not options.has_value()) {
+        advent::println("Usage: {} <day> <generator> <scale>... [--seed <seed>] [--bench <iterations>] [--warn-above <exponent>]", argv[0]);
+
+        return 1;
+    }
+
+    const auto input_path = std::filesystem::temp_directory_path() / std::format("advent_sweep_{}.txt", std::filesystem::path(options->day).filename().string());
+
+    advent::scope_guard _ = [&]() {
+        std::error_code error;
+
+        std::filesystem::remove(input_path, error);
+    };
+
+    /* NOTE: We only need the part and its median time from each record. */
+    static const auto RecordPattern = std::regex(R"re("part":(\d+),.*"nanoseconds":(\d+),)re");
+
+    std::map<std::size_t, std::vector<Sample>> samples_by_part;
+
+    for (const auto scale : options->scales) {
+        const auto generated = advent::run_command(std::format(
+            "{} {} --seed {} > {}",
+
+            advent::shell_quoted(options->generator), scale, options->seed, advent::shell_quoted(input_path.string())
+        ));
+
+        if (not generated.has_value()) {
+            advent::println("Unable to generate input at scale {}!", scale);
+
+            return 1;
+        }
+
+        const auto output = advent::run_command(std::format(
+            "{} {} --format json --bench {}",
+
+            advent::shell_quoted(options->day), advent::shell_quoted(input_path.string()), options->bench_iterations
+        ));
+
+        if (not output.has_value()) {
+            advent::println("Unable to solve input at scale {}!", scale);
+
+            return 1;
+        }
+
+        for (const auto line : *output | std::views::split('\n')) {
+            const auto record = std::string(std::from_range, line);
+
+            std::smatch match;
+            if (not std::regex_search(record, match, RecordPattern)) {
+                continue;
+            }
+
+            const auto part     = advent::to_integral<std::size_t>(std::string_view(match[1].first, match[1].second));
+            const auto duration = advent::to_integral<std::size_t>(std::string_view(match[2].first, match[2].second));
+
+            samples_by_part[part].emplace_back(scale, std::chrono::nanoseconds(duration));
+        }
+    }
+
+    advent::println("Part\tScale\t\tMedian time");
+
+    for (const auto &[part, samples] : samples_by_part) {
+        const auto name = (part == 0) ? std::string("parse") : std::format("{}", part);
+
+        for (const auto &sample : samples) {
+            advent::println("{}\t{}\t\t{:.3}", name, sample.scale, advent::scaled_duration(sample.duration));
+        }
+
+        const auto exponent = fit_exponent(samples);
+
+        advent::println(
+            "{}\tgrows as about scale^{:.2f}{}",
+
+            name, exponent,
+
+            (exponent > options->warn_above) ? "\t<-- superlinear" : ""
+        );
+
+        advent::println();
+    }
+
+    return 0;
+}